@@ -2,12 +2,17 @@
 
 #include <string>
 #include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
 #include <queue>
 #include <cmath>
 #include <ctime>
 #include <random>
 #include <memory>
 #include <iostream>
+#include <algorithm>
+#include <cstddef>
 
 #include <jni.h>
 
@@ -22,11 +27,17 @@
 #include <sstream>
 
 #include "tools/tools.hpp"
+#include "tools/TickScheduler.hpp"
+#include "tools/Histogram.hpp"
+#include "tools/Clock.hpp"
+#include "tools/Trace.hpp"
 
-#include "shapes/Circle.hpp"
-#include "shapes/Object.hpp"
+#include "shapes/MeshRegistry.hpp"
+#include "shapes/Quad.hpp"
+#include "shapes/World.hpp"
 
 #include "bboycore.hpp"
+#include "bboygame.hpp"
 
 
 
@@ -35,18 +46,12 @@ static bool initOpenGL();
 static bool initOpenGLObjects();
 static void runGameLoop();
 static bool setupScreen(int, int);
-static void processInput();
 static void renderFrame();
-static void updateTime();
-static void updateGame();
-static void stepGame();
-static void pauseGame();
-static void resumeGame();
 static void pauseGameEngine();
 static void resumeGameEngine();
 static void shutdown();
-static void storeEvent(std::vector<struct EventItem> const&);
-static void drawTouchDot();
+static void drawTouchDot(RenderSnapshot const&, float);
+static void logSchedulerStats();
 
 
 static auto boxVertices = {1.0f, 1.0f, 0.0f,
@@ -67,6 +72,49 @@ static auto fragmentShader =
         "  gl_FragColor = color;\n"
         "}\n";
 
+// per instance model matrix and color (see QuadInstance), attribute locations match bboycore.hpp
+static auto instancedVertexShader =
+        "#version 300 es\n"
+        "uniform mat4 uVPMatrix;\n"
+        "layout(location = 0) in vec4 vPosition;\n"
+        "layout(location = 1) in vec4 iColor;\n"
+        "layout(location = 2) in mat4 iModel;\n"
+        "out vec4 fColor;\n"
+        "void main() {\n"
+        "  gl_Position = uVPMatrix * iModel * vPosition;\n"
+        "  fColor = iColor;\n"
+        "}\n";
+
+// one line loop per box, the corners come from gl_VertexID (min, (max.x, min.y), max, (min.x, max.y))
+static auto aabbVertexShader =
+        "#version 300 es\n"
+        "uniform mat4 uVPMatrix;\n"
+        "layout(location = 0) in vec2 iMin;\n"
+        "layout(location = 1) in vec2 iMax;\n"
+        "void main() {\n"
+        "  float x = (gl_VertexID == 1 || gl_VertexID == 2) ? iMax.x : iMin.x;\n"
+        "  float y = (gl_VertexID >= 2) ? iMax.y : iMin.y;\n"
+        "  gl_Position = uVPMatrix * vec4(x, y, 0.0, 1.0);\n"
+        "}\n";
+
+static auto aabbFragmentShader =
+        "#version 300 es\n"
+        "precision mediump float;\n"
+        "uniform vec4 color;\n"
+        "out vec4 fragColor;\n"
+        "void main() {\n"
+        "  fragColor = color;\n"
+        "}\n";
+
+static auto instancedFragmentShader =
+        "#version 300 es\n"
+        "precision mediump float;\n"
+        "in vec4 fColor;\n"
+        "out vec4 fragColor;\n"
+        "void main() {\n"
+        "  fragColor = fColor;\n"
+        "}\n";
+
 void printGLString(const char *name, GLenum s) {
     auto *v = glGetString(s);
     LOGI("GL %s = %s\n", name, v);
@@ -187,232 +235,197 @@ GLuint createProgram(const char *vtxSrc, const char *fragSrc) {
 }
 
 // ===== program start =====
-static GLuint program;
-static int yeeNum;
-static float bgColor;
-
-static struct timespec prevTimeUPS;
-static struct timespec prevTimeSPS;
-static struct timespec prevTimeFPS;
-static struct timespec timeDiff;
-static bool paused;
-static bool enginePaused;
-static float colorUpdate;
-
-static float sps;
-static float fps;
-static float ups;
-static float true_ups;
-static float lag;
-static float interpolation;
-
-static int screenWidth;
-static int screenHeight;
-
-static float worldWidth;
-static float worldHeight;
-
-// NOTE: Probably remove current position list off to be NOT lingering
-static std::vector<struct EventItem> curPositionList;
-static std::vector<struct EventItem> rawPositionList;
-
-static std::mutex pauseMutex;
-
-static std::queue<std::vector<struct EventItem>> inputBuffer;
-static std::queue<std::vector<struct EventItem>> rawInputBuffer;
-
-static std::thread gameLoop;
-static bool running;
+static GLProgram program;
+// draws every quad in one call
+static GLProgram instancedProgram;
+// draws every aabb outline in one call
+static GLProgram aabbProgram;
+
+static int64_t prevTimeFPS;
+
+// written by the render thread, published with the rest of the telemetry by the game thread
+static std::atomic<float> fps;
+
+// stats shared with kotlin through a direct ByteBuffer (see BBoyTelemetry.kt, the layout must match)
+// single writer (the game thread) seqlock, the sequence is odd while the block is being written
+struct TelemetryBlock {
+    std::atomic<uint32_t> sequence;
+    uint32_t version;
+    float fps;
+    float ups;
+    float trueUps;
+    float sps;
+    int64_t frame;
+    int64_t steppedFrame;
+    int64_t curTime;
+};
+
+#define TELEMETRY_VERSION 1
+static_assert(offsetof(TelemetryBlock, fps) == 8 && offsetof(TelemetryBlock, frame) == 24 &&
+              offsetof(TelemetryBlock, curTime) == 40 && sizeof(TelemetryBlock) == 48,
+              "TelemetryBlock layout is shared with BBoyTelemetry.kt");
+
+static TelemetryBlock telemetry;
+
+// pointer positions shared with kotlin through a direct ByteBuffer (see BBoyPointers.kt, the layout must match)
+// x, y (screen) and normX, normY (world) per pointer
+struct PointerSlot {
+    // seqlock, odd while the slot is being written
+    std::atomic<uint32_t> sequence;
+    uint32_t count;
+    float values[MAX_POINTER_SIZE * 4];
+};
+
+// double buffered so a reader of the latest slot only races the writer every other publish
+struct PointerBlock {
+    // number of publishes so far, the latest slot is latest & 1
+    std::atomic<uint32_t> latest;
+    uint32_t version;
+    PointerSlot slots[2];
+};
+
+#define POINTER_BLOCK_VERSION 1
+static_assert(offsetof(PointerSlot, values) == 8 && sizeof(PointerSlot) == 8 + MAX_POINTER_SIZE * 16 &&
+              offsetof(PointerBlock, slots) == 8,
+              "PointerBlock layout is shared with BBoyPointers.kt");
+
+static PointerBlock pointers;
+
+// tail latency of the render thread (frame to frame interval and time spent rendering)
+static RollingHistogram frameTimes(TIMING_SLICE_NS, TIMING_SLICE_COUNT);
+static RollingHistogram renderTimes(TIMING_SLICE_NS, TIMING_SLICE_COUNT);
+
+// engine lifecycle, commands come from the android threads and the game thread follows
+// CREATED -> RUNNING once opengl is ready, RUNNING <-> PAUSED on pause / resume, any -> STOPPING on stop
+enum class EngineState : uint8_t {
+    CREATED,
+    RUNNING,
+    PAUSED,
+    STOPPING
+};
+
+enum class EngineCommand : uint8_t {
+    START,
+    OPENGL_READY,
+    PAUSE,
+    RESUME,
+    STOP
+};
+
+// read lock free by the game loop, only ever written under stateMutex
+static std::atomic<EngineState> engineState;
+static std::mutex stateMutex;
+static std::condition_variable stateCondition;
+// requested by commands (guarded by stateMutex), engineState is derived from these
 static bool openGLReady;
+static bool pauseRequested;
+static bool stopRequested;
+// surface size posted by setupScreen (guarded by stateMutex), the game thread resizes the world between ticks
+static bool screenResized;
+static int pendingScreenWidth;
+static int pendingScreenHeight;
+// input log requested before START (guarded by stateMutex), opened once the world has its first size
+static std::string pendingRecordPath;
+static bool pendingRecordChecksums;
+// game thread only, nothing ticks until the world knows the screen size
+static bool worldSized;
+static int worldScreenWidth;
+static int worldScreenHeight;
 
-static std::set<Object*> allGameObjects;
-static std::set<Object*> rootGameObjects;
-
-static struct timespec startTime;
-static struct timespec curTime;
-
-static uint64_t currentFrame;
-static uint64_t currentSteppedFrame;
+static std::thread gameLoop;
+// paces the game loop (sleeps between ticks, input wakes it early)
+static TickScheduler tickScheduler(TICK_SPIN_NS);
 
 static GLint mvpMatrixLoc;
 static GLint colorVecLoc;
-
-static std::mt19937 rng;
-
-static Circle circle;
-static Object originPoint;
-static Object* pointerList[MAX_POINTER_SIZE];
-
-static Object puckObject;
-static Object player1Object;
-static Object player2Object;
+static GLint vpMatrixLoc;
+static GLint aabbVPMatrixLoc;
+static GLint aabbColorVecLoc;
+
+// created with the GL context (not at load time, there is no context yet)
+static MeshRegistry meshes;
+// scratch for the interpolated world matrices and the quad instances (render thread only)
+static std::vector<glm::mat4> worldMatrices;
+static std::vector<QuadInstance> quadInstances;
+static std::vector<AABBInstance> aabbInstances;
 // =========================
 
-// normalization formula : x between [a, b]
-// https://stats.stackexchange.com/questions/178626/how-to-normalize-data-between-1-and-1
-void convertScreenCoordToWorldCoord(struct EventItem& position) {
-    // need to -1 in width and height for 0th offset
-    float xPos = worldWidth * position.x / (screenWidth - 1) - (worldWidth / 2);
-    float yPos = worldHeight * position.y / (screenHeight - 1) - (worldHeight / 2);
-
-    // negative y ratio since screen is top to bottom while coordinates is bottom to top
-    position.x = xPos;
-    position.y = -yPos;
-}
-
-
-struct EventItem convertScreenCoordToWorldCoord(struct EventItem const& position) {
-    // need to -1 in width and height for 0th offset
-    float xPos = worldWidth * position.x / (screenWidth - 1) - (worldWidth / 2);
-    float yPos = worldHeight * position.y / (screenHeight - 1) - (worldHeight / 2);
-
-    // negative y ratio since screen is top to bottom while coordinates is bottom to top
-    return { xPos, -yPos };
-}
-
-void convertWorldCoordToScreenCoord(struct EventItem& position) {
-    // need to -1 in width and height for 0th offset
-    float xPos = (screenWidth - 1) * (position.x + worldWidth / 2) / worldWidth;
-    float yPos = (screenHeight - 1) * (position.y + worldHeight / 2) / worldHeight;
-
-    // negative y ratio since screen is top to bottom while coordinates is bottom to top
-    position.x = xPos;
-    position.y = -yPos;
-}
-
-struct EventItem convertWorldCoordToScreenCoord(struct EventItem const& position) {
-    // need to -1 in width and height for 0th offset
-    float xPos = (screenWidth - 1) * (position.x + worldWidth / 2) / worldWidth;
-    float yPos = (screenHeight - 1) * (position.y + worldHeight / 2) / worldHeight;
-
-    // negative y ratio since screen is top to bottom while coordinates is bottom to top
-    return { xPos, -yPos };
-}
-
-static float getElapsedTime(struct timespec const& prevTime, struct timespec const& curTime) {
-    // calculate elapsed time between prev and cur
-    __kernel_long_t elapsedSec = curTime.tv_sec - prevTime.tv_sec;
-    long elapsedNSec = curTime.tv_nsec - prevTime.tv_nsec;
-
-    // subtraction carry
-    if (prevTime.tv_nsec > curTime.tv_nsec) {
-        --elapsedSec;
-        elapsedNSec += BILLION;
-    }
-
-    // convert to float
-    float elapsed = elapsedSec + elapsedNSec / BILLION_FLOAT;
-
-    return elapsed;
-}
-
 static void initProgram() {
     LOGI("initProgram");
 
     // initialise variables
-    yeeNum = 0;
-    bgColor = 0.0f;
-
-//    struct timespec res;
-//    clock_gettime(CLOCK_MONOTONIC, &res);
-//    prevTimeFPS = res;
-//    prevTimeUPS = res;
-//    prevTimeSPS = res;
-//    curTime = res;
-//    startTime = res;
-
-    colorUpdate = 0.02f;
-
-    sps = 0.0f;
-    fps = 0.0f;
-    ups = 0.0f;
-    true_ups = 0.0f;
-    lag = 0.0f;
-    interpolation = 0.0f;
-
-    currentFrame = 0;
-    currentSteppedFrame = 0;
-
-    clock_gettime(CLOCK_MONOTONIC, &curTime);
-    clock_gettime(CLOCK_MONOTONIC, &startTime);
+    fps.store(0.0f, std::memory_order_relaxed);
+    telemetry.version = TELEMETRY_VERSION;
+    pointers.version = POINTER_BLOCK_VERSION;
 
-    rng.seed(std::random_device()());
+    initGame();
+    // the world outlives GL contexts, only the meshes are uploaded again
+    initGameObjects();
 
-    running = false;
     openGLReady = false;
-    paused = false;
-    enginePaused = false;
+    pauseRequested = false;
+    stopRequested = false;
+    screenResized = false;
+    pendingRecordPath.clear();
+    worldSized = false;
+    engineState.store(EngineState::CREATED);
 }
 
 static bool initOpenGL() {
     LOGI("initOpenGL");
+    TRACE_THREAD_NAME("render");
 
     printGLString("Version", GL_VERSION);
     printGLString("Vendor", GL_VENDOR);
     printGLString("Renderer", GL_RENDERER);
     printGLString("Extensions", GL_EXTENSIONS);
 
-    program = createProgram(vertexShader, fragmentShader);
+    // a new context, anything owned from the previous one is gone with it
+    glContextGeneration()++;
+
+    program = GLProgram(createProgram(vertexShader, fragmentShader));
     if (!program) {
         LOGE("Could not create program.");
         return false;
     }
     checkGLError("createProgram");
 
+    instancedProgram = GLProgram(createProgram(instancedVertexShader, instancedFragmentShader));
+    if (!instancedProgram) {
+        LOGE("Could not create instanced program.");
+        return false;
+    }
+    checkGLError("createProgram");
+    vpMatrixLoc = glGetUniformLocation(instancedProgram.get(), "uVPMatrix");
+
+    aabbProgram = GLProgram(createProgram(aabbVertexShader, aabbFragmentShader));
+    if (!aabbProgram) {
+        LOGE("Could not create aabb program.");
+        return false;
+    }
+    checkGLError("createProgram");
+    aabbVPMatrixLoc = glGetUniformLocation(aabbProgram.get(), "uVPMatrix");
+    aabbColorVecLoc = glGetUniformLocation(aabbProgram.get(), "color");
+
     // setup face culling
     glEnable(GL_CULL_FACE);
     checkGLError("glEnable");
 
     // setup program (shaders)
-    glUseProgram(program);
+    glUseProgram(program.get());
     checkGLError("glUseProgram");
 
     // get uniform variable location in GPU
-    mvpMatrixLoc = glGetUniformLocation(program, "uMVPMatrix");
-    colorVecLoc = glGetUniformLocation(program, "color");
+    mvpMatrixLoc = glGetUniformLocation(program.get(), "uMVPMatrix");
+    colorVecLoc = glGetUniformLocation(program.get(), "color");
     glUniformMatrix4fv(mvpMatrixLoc, 1, GL_FALSE, glm::value_ptr(glm::mat4(1)));
     glUniform4fv(colorVecLoc, 1, glm::value_ptr(glm::vec4(1.0f, 0.0f, 0.0f, 1.0f)));
 
-    openGLReady = true;
-
     return true;
 }
 
-// TODO decouple this from OPENGL renderer (so it doenst call shit)
 static bool initOpenGLObjects() {
-    circle = Circle();
-    originPoint = Object();
-    auto childObj = std::make_unique<Object>();
-
-    for (auto& item : pointerList) {
-        delete item;
-        item = new Object();
-        allGameObjects.emplace(item);
-        rootGameObjects.emplace(item);
-    }
-
-    // create puck and two handles
-    puckObject = Object();
-    puckObject.velocity = glm::vec3(0.05f, 0.05f, 0.0f);
-    player1Object = Object();
-    player2Object = Object();
-
-    // add to list of game objects
-    allGameObjects.emplace(&puckObject);
-    allGameObjects.emplace(&player1Object);
-    allGameObjects.emplace(&player2Object);
-    allGameObjects.emplace(&originPoint);
-    allGameObjects.emplace(childObj.get());
-
-    rootGameObjects.emplace(&puckObject);
-    rootGameObjects.emplace(&player1Object);
-    rootGameObjects.emplace(&player2Object);
-    rootGameObjects.emplace(&originPoint);
-
-    // modify objects
-    originPoint.translation = glm::vec3(0, 10, 0);
-    childObj->translation = glm::vec3(10, 0, 0);
-    originPoint.addChild(std::move(childObj));
+    meshes.create();
 
     return true;
 }
@@ -420,293 +433,155 @@ static bool initOpenGLObjects() {
 static bool setupScreen(int w, int h) {
     LOGI("setupScreen(%d, %d)", w, h);
 
-    screenWidth = w;
-    screenHeight = h;
-
-    // get ratio
-    float aspectRatio = static_cast<float>(w) / static_cast<float>(h);
-    if (aspectRatio >= 1.0f) {
-        worldHeight = WORLD_SIZE / aspectRatio;
-        worldWidth = WORLD_SIZE;
-    } else {
-        worldHeight = WORLD_SIZE;
-        worldWidth = WORLD_SIZE * aspectRatio;
+    // the world (and the broadphase grid) may be mid tick on the game thread, only post the size
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        screenResized = true;
+        pendingScreenWidth = w;
+        pendingScreenHeight = h;
     }
 
     glViewport(0, 0, w, h);
     return !checkGLError("glViewport");
 }
 
-static void stepGame() {
-    currentSteppedFrame++;
-
-    yeeNum++;
-    yeeNum %= TIME_STEP;
-
-    // increase vs decrease color
-    bgColor += colorUpdate;
-
-    // toggle color
-    if (bgColor > 1.0f) {
-        colorUpdate = -1.0f * MS_PER_UPDATE / 2;
-    }
-
-    if (bgColor < 0.0f) {
-        colorUpdate = +1.0f * MS_PER_UPDATE / 2;
-    }
-
-    // clamp bgcolor to [0, 1]
-    bgColor = glm::clamp(bgColor, 0.0f, 1.0f);
-
-    // update random position between [-20, 20]
-//    if (yeeNum == 0) {
-//        std::uniform_real_distribution<float> rngPos(-20, 20);
-//        float x = rngPos(rng);
-//        float y = rngPos(rng);
-//    }
-
-    // disable non updated pointers
-    for (auto const& item : pointerList) {
-        if (item == nullptr) {
-            continue;
-        }
-        item->isActive = false;
-    }
-
-    // update the position of pointers
-    for (int i = 0; i < curPositionList.size(); ++i) {
-        if (pointerList[i] == nullptr) {
-            continue;
-        }
-        pointerList[i]->translation = glm::vec3(curPositionList[i].x, curPositionList[i].y, 0.0f);
-        pointerList[i]->isActive = true;
-    }
-
-    // update the rotation of the cool object
-    originPoint.rotation = glm::rotate(originPoint.rotation, glm::radians(1.0f), glm::vec3(0.0f, 0.0f, 1.0f));
-    originPoint.rotation = glm::normalize(originPoint.rotation);
-
-    // update TRS of puck and players
-    player1Object.translation = glm::vec3(0.0f, -20.0f, 0.0f);
-    player2Object.translation = glm::vec3(0.0f, 20.0f, 0.0f);
-
-    std::set<Object*> collidedObjects;
-    std::set<Object*> nonCollidedObjects;
-
-    // update objects
-    for (auto const& it : rootGameObjects) {
-        it->Update();
-    }
-
-    // custom code for puck updating
-    if (puckObject.translation.x < -worldWidth / 2 || puckObject.translation.x > worldWidth / 2) {
-        puckObject.velocity.x = -puckObject.velocity.x;
-    }
-
-    if (puckObject.translation.y < -worldHeight/ 2 || puckObject.translation.y > worldHeight / 2) {
-        std::uniform_real_distribution<float> rngVel(-0.05f, 0.05f);
-        float v = rngVel(rng);
-        puckObject.velocity = glm::vec3(v, v, 0.0f);
-        puckObject.translation = glm::vec3(5.0f, 0.0f, 0.0f);
-    }
-
-    // check collision
-    for (auto const& it : allGameObjects) {
-        // skip for inactive objects
-        if (!it->isActive) {
-            continue;
+static void sendEngineCommand(EngineCommand command) {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+
+        switch (command) {
+            case EngineCommand::START:
+                stopRequested = false;
+                break;
+            case EngineCommand::OPENGL_READY:
+                openGLReady = true;
+                break;
+            case EngineCommand::PAUSE:
+                pauseRequested = true;
+                break;
+            case EngineCommand::RESUME:
+                pauseRequested = false;
+                break;
+            case EngineCommand::STOP:
+                stopRequested = true;
+                break;
         }
-        // find a list of objects which have collided
-        for (auto const& other : allGameObjects) {
-            // skip if me == other
-            if (it == other) {
-                continue;
-            }
-
-            // skip for inactive objects
-            if (!other->isActive) {
-                continue;
-            }
-
-            if (it->checkCollision(*other)) {
-                // load a list of collided objects
-                collidedObjects.emplace(it);
-                collidedObjects.emplace(other);
-            }
-        }
-    }
-
-    // set collided objects to a yellow color
-    for (auto const& it : collidedObjects) {
-        if (it == &puckObject) {
-            it->velocity.y = -(it->velocity.y * 1.1f);
-            it->velocity.x = -(it->velocity.x * 1.1f);
-        }
-        it->color = glm::vec4(1.0f, 1.0f, 0.0f, 1.0f);
-    }
-
-    std::set_difference(allGameObjects.begin(), allGameObjects.end(), collidedObjects.begin(), collidedObjects.end(), std::inserter(nonCollidedObjects, nonCollidedObjects.end()));
-    for (auto const& it : nonCollidedObjects) {
-        it->color = glm::vec4(0.0f, 1.0f, 0.0f, 1.0f);
-    }
-}
-
-static void updateTime() {
-    // update previous time to current time
-    struct timespec res;
-    clock_gettime(CLOCK_MONOTONIC, &res);
-
-    // store current time
-    curTime = res;
-    prevTimeUPS = res;
-}
-
-static void updateGame() {
-    // calculate time elapsed from previous update
-    struct timespec res;
-    clock_gettime(CLOCK_MONOTONIC, &res);
-    float elapsed = getElapsedTime(prevTimeUPS, res);
-    lag += elapsed;
-
-    // update time before stepping game
-    curTime = res;
-    prevTimeUPS = res;
 
-    // num steps per update call
-    int stepCounter = 0;
-
-    // update in steps
-    while (lag >= MS_PER_UPDATE && stepCounter < MAX_FRAME_SKIP) {
-        if (!paused) {
-            stepGame();
+        // repeated pause / resume commands fall out as no-ops here
+        EngineState state = EngineState::RUNNING;
+        if (stopRequested) {
+            state = EngineState::STOPPING;
+        } else if (!openGLReady) {
+            state = EngineState::CREATED;
+        } else if (pauseRequested) {
+            state = EngineState::PAUSED;
         }
-        lag -= MS_PER_UPDATE;
-
-        currentFrame++;
-        stepCounter++;
-
-//        // update steps per second counter
-//        float elapsedSPS = getElapsedTime(prevTimeSPS, res);
-//        if (elapsedSPS != 0.0f) {
-//            sps = MOVING_AVERAGE_ALPHA * sps + (1.0f - MOVING_AVERAGE_ALPHA) / elapsedSPS;
-//        }
-//        prevTimeSPS = res;
-    }
 
-    if (!paused) {
-        interpolation = lag / MS_PER_UPDATE;
+        engineState.store(state, std::memory_order_release);
     }
 
-    // update debug counters
-    true_ups = MOVING_AVERAGE_ALPHA * true_ups + (1.0f - MOVING_AVERAGE_ALPHA) / elapsed;
-
-    if (stepCounter > 0) {
-        ups = MOVING_AVERAGE_ALPHA * ups + (1.0f - MOVING_AVERAGE_ALPHA) * stepCounter / elapsed;
-
-        float elapsedSPS = getElapsedTime(prevTimeSPS, res);
-        sps = MOVING_AVERAGE_ALPHA * sps + (1.0f - MOVING_AVERAGE_ALPHA) * stepCounter / elapsedSPS;
-        prevTimeSPS = res;
-    }
+    // wake the game loop wherever it is blocked
+    stateCondition.notify_all();
+    tickScheduler.notify();
 }
 
-static void pauseGame() {
-    paused = true;
-}
+// game thread only, blocks while the engine is not running and returns the state it left on
+static EngineState waitForEngine() {
+    std::unique_lock<std::mutex> lock(stateMutex);
+    stateCondition.wait(lock, [] {
+        EngineState state = engineState.load(std::memory_order_relaxed);
+        return state == EngineState::RUNNING || state == EngineState::STOPPING;
+    });
 
-static void resumeGame() {
-    paused = false;
+    return engineState.load(std::memory_order_relaxed);
 }
 
 static void pauseGameEngine() {
-    // dont attempt to grab mutex again (from android UI thread)
-    if (enginePaused) {
-        return;
-    }
-
-    // set flag before attempting to lock
-    enginePaused = true;
-    pauseMutex.lock();
-
-    struct timespec res;
-    clock_gettime(CLOCK_MONOTONIC, &res);
-
-    // store time difference
-    timeDiff.tv_sec = res.tv_sec - prevTimeUPS.tv_sec;
-    timeDiff.tv_nsec = res.tv_nsec - prevTimeUPS.tv_nsec;
+    sendEngineCommand(EngineCommand::PAUSE);
 }
 
 static void resumeGameEngine() {
-    // set flag only after unlock attempt
-    pauseMutex.unlock();
-    enginePaused = false;
-
-    // restore time difference
-    struct timespec res;
-    clock_gettime(CLOCK_MONOTONIC, &res);
-
-    prevTimeUPS.tv_sec = res.tv_sec - timeDiff.tv_sec;
-    prevTimeUPS.tv_nsec = res.tv_nsec - timeDiff.tv_nsec;
+    sendEngineCommand(EngineCommand::RESUME);
 }
 
-static void storeEvent(std::vector<struct EventItem> const& event) {
-    // convert android xy coords to world coords
-    std::vector<struct EventItem> convertedList;
-    for (auto& item : event) {
-        struct EventItem convertedEvent = convertScreenCoordToWorldCoord(item);
-        convertedList.emplace_back(convertedEvent);
-    }
-
-    rawInputBuffer.push(event);
-    inputBuffer.push(convertedList);
+static void logSchedulerStats() {
+    SchedulerStats stats = tickScheduler.getStats();
+    LOGI("scheduler: %llu ticks, %llu late, %llu wakeups, overshoot mean %lld ns max %lld ns",
+         static_cast<unsigned long long>(stats.ticks), static_cast<unsigned long long>(stats.late),
+         static_cast<unsigned long long>(stats.wakeups), static_cast<long long>(stats.meanOvershoot),
+         static_cast<long long>(stats.maxOvershoot));
+    tickScheduler.resetStats();
 }
 
-static void processInput() {
-    if (inputBuffer.empty()) {
-        return;
-    }
+// game thread only
+static void publishTelemetry() {
+    GameStats stats = getGameStats();
+    uint32_t sequence = telemetry.sequence.load(std::memory_order_relaxed);
 
-    std::vector<struct EventItem> s = inputBuffer.front();
-    inputBuffer.pop();
+    telemetry.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
 
-    // ignore input if paused
-    if (paused) {
-        return;
-    }
+    telemetry.fps = fps.load(std::memory_order_relaxed);
+    telemetry.ups = stats.ups;
+    telemetry.trueUps = stats.trueUps;
+    telemetry.sps = stats.sps;
+    telemetry.frame = static_cast<int64_t>(stats.frame);
+    telemetry.steppedFrame = static_cast<int64_t>(stats.steppedFrame);
+    telemetry.curTime = stats.curTime;
 
-    curPositionList = s;
+    telemetry.sequence.store(sequence + 2, std::memory_order_release);
 }
 
-static void processRawInput() {
-    if (rawInputBuffer.empty()) {
-        return;
-    }
-
-    std::vector<struct EventItem> s = rawInputBuffer.front();
-    rawInputBuffer.pop();
-
-    // ignore input if paused
-    if (paused) {
-        return;
+// game thread only
+static void publishPointers() {
+    std::vector<struct EventItem> const& curPositionList = getPositionList();
+    std::vector<struct EventItem> const& rawPositionList = getRawPositionList();
+
+    uint32_t latest = pointers.latest.load(std::memory_order_relaxed) + 1;
+    PointerSlot& slot = pointers.slots[latest & 1];
+    uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    size_t count = std::min(curPositionList.size(), static_cast<size_t>(MAX_POINTER_SIZE));
+    slot.count = static_cast<uint32_t>(count);
+    for (size_t i = 0; i < count; ++i) {
+        slot.values[i * 4] = rawPositionList[i].x;
+        slot.values[i * 4 + 1] = rawPositionList[i].y;
+        slot.values[i * 4 + 2] = curPositionList[i].x;
+        slot.values[i * 4 + 3] = curPositionList[i].y;
     }
 
-    rawPositionList = s;
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+    pointers.latest.store(latest, std::memory_order_release);
 }
 
 static void renderFrame() {
+    TRACE_ZONE("renderFrame");
+
+    int64_t renderStart = Clock::monotonicNow();
+
     // update fps average counter
     // obtain time elapsed for fps
-    struct timespec res;
-    clock_gettime(CLOCK_MONOTONIC, &res);
-    float elapsed = getElapsedTime(prevTimeFPS, res);
+    int64_t now = getGameTime();
+    float elapsed = (now - prevTimeFPS) / BILLION_FLOAT;
+    frameTimes.record(now - prevTimeFPS, renderStart);
 
     // store current times
-    prevTimeFPS = res;
+    prevTimeFPS = now;
 
     // calculate fps here
-    fps = MOVING_AVERAGE_ALPHA * fps + (1.0f - MOVING_AVERAGE_ALPHA) / elapsed;
+    fps.store(MOVING_AVERAGE_ALPHA * fps.load(std::memory_order_relaxed) + (1.0f - MOVING_AVERAGE_ALPHA) / elapsed,
+              std::memory_order_relaxed);
+
+    // blend between the last two ticks by how far into the next tick we are
+    RenderSnapshot const& snapshot = getRenderSnapshot();
+    float alpha = (now - snapshot.time) / (MS_PER_UPDATE * BILLION_FLOAT);
+    alpha = glm::clamp(alpha, 0.0f, 1.0f);
 
     // interpolate bgColor
-    GLfloat interpBgColor = bgColor + colorUpdate * interpolation;
+    GLfloat interpBgColor = glm::mix(snapshot.prevBgColor, snapshot.bgColor, alpha);
 
     glClearColor(interpBgColor, interpBgColor, interpBgColor, 1.0f);
     checkGLError("glClearColor");
@@ -715,11 +590,14 @@ static void renderFrame() {
     checkGLError("glClear");
 
     // draw dot
-    drawTouchDot();
+    drawTouchDot(snapshot, alpha);
+
+    renderTimes.record(Clock::monotonicNow() - renderStart, renderStart);
 }
 
-// @TODO convert to renderer with interpolation
-static void drawTouchDot() {
+static void drawTouchDot(RenderSnapshot const& snapshot, float alpha) {
+    TRACE_ZONE("drawTouchDot");
+
     // place ortho camera to bottom left as 0,0
     // glm::mat4 orthoMat = glm::ortho(0.0f, (float)width, 0.0f, (float)height);
 
@@ -735,6 +613,13 @@ static void drawTouchDot() {
     //        |                            -25
     //       -50
 
+    // nothing to project until the game thread has published a sized world
+    float worldWidth = snapshot.worldWidth;
+    float worldHeight = snapshot.worldHeight;
+    if (worldWidth <= 0.0f || worldHeight <= 0.0f) {
+        return;
+    }
+
     glm::mat4 orthoMat = glm::ortho(-worldWidth/2.0f, worldWidth/2.0f, -worldHeight/2.0f, worldHeight/2.0f);
     glm::mat4 modelMat, mat;
 
@@ -745,44 +630,64 @@ static void drawTouchDot() {
     glUniform4fv(colorVecLoc, 1, glm::value_ptr(glm::vec4(0.0f, 0.0f, 1.0f, 1.0f)));
 
     // draw random circle
-    circle.Draw();
+    meshes.getCircle().Draw();
 
     // translate the triangle to move it
     modelMat = glm::mat4(1.0f);
     mat = orthoMat * modelMat;
 
-    // draw all gameobjects
-    for (auto const& it : allGameObjects) {
-        // skip for non root objects
-        if (it->parent != nullptr) {
-            continue;
-        }
+    std::vector<RenderItem> const& items = snapshot.items;
+    size_t entityCount = items.size();
+
+    // rebuild the world matrices from the interpolated local transforms (parents come before children)
+    worldMatrices.resize(entityCount);
+    for (size_t i = 0; i < entityCount; ++i) {
+        RenderItem const& item = items[i];
+        glm::mat4 localMat = glm::translate(glm::mix(item.prevTranslation, item.translation, alpha)) *
+                             glm::toMat4(glm::slerp(item.prevRotation, item.rotation, alpha)) *
+                             glm::scale(glm::mix(item.prevScale, item.scale, alpha));
+
+        worldMatrices[i] = item.parent == WORLD_NO_PARENT ? localMat : worldMatrices[item.parent] * localMat;
+    }
 
+    // draw all gameobjects (one instanced call for every active quad)
+    quadInstances.clear();
+    for (size_t i = 0; i < entityCount; ++i) {
         // skip for inactive objects
-        if (!it->isActive) {
+        if (!items[i].active || items[i].mesh != MeshType::QUAD) {
             continue;
         }
 
-        // draw
-        it->Draw(mat, mvpMatrixLoc, colorVecLoc);
+        quadInstances.push_back({worldMatrices[i], items[i].color});
     }
 
-    // draw aabb
-    for (auto const& it : allGameObjects) {
-        // skip for non root objects
-        if (it->parent != nullptr) {
-            continue;
-        }
+    glUseProgram(instancedProgram.get());
+    glUniformMatrix4fv(vpMatrixLoc, 1, GL_FALSE, glm::value_ptr(mat));
+    Quad& quad = meshes.getQuad();
+    quad.SetInstances(quadInstances);
+    quad.DrawInstanced();
 
+    // draw aabb (one instanced line loop for every active box)
+    aabbInstances.clear();
+    for (size_t i = 0; i < entityCount; ++i) {
         // skip for inactive objects
-        if (!it->isActive) {
+        if (!items[i].active) {
             continue;
         }
 
-        // draw AABB
-        it->DrawAABB(mat, mvpMatrixLoc, colorVecLoc);
+        glm::vec2 boundsMin = glm::mix(glm::vec2(items[i].prevBounds.min), glm::vec2(items[i].bounds.min), alpha);
+        glm::vec2 boundsMax = glm::mix(glm::vec2(items[i].prevBounds.max), glm::vec2(items[i].bounds.max), alpha);
+        aabbInstances.push_back({boundsMin, boundsMax});
     }
 
+    glUseProgram(aabbProgram.get());
+    glUniformMatrix4fv(aabbVPMatrixLoc, 1, GL_FALSE, glm::value_ptr(mat));
+    glUniform4fv(aabbColorVecLoc, 1, glm::value_ptr(glm::vec4(0.0f, 0.0f, 0.0f, 1.0f)));
+    AABBOverlay& aabbOverlay = meshes.getAABBOverlay();
+    aabbOverlay.SetBounds(aabbInstances);
+    aabbOverlay.Draw();
+    glUseProgram(program.get());
+
 //    // draw objects with a scene graph (origin point at 10.0f on y axis)
 //    originPoint.Draw(mat, mvpMatrixLoc, colorVecLoc);
 //    originPoint.DrawAABB(mat, mvpMatrixLoc, colorVecLoc);
@@ -795,47 +700,121 @@ static void drawTouchDot() {
     glBindVertexArray(0);
 }
 
+// game thread only, picks up a surface size posted by setupScreen
+static void applyScreenSize() {
+    int width;
+    int height;
+    std::string recordPath;
+    bool recordChecksums = false;
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        if (!screenResized) {
+            return;
+        }
+        screenResized = false;
+        width = pendingScreenWidth;
+        height = pendingScreenHeight;
+        // a recording only ever starts with the world, later requests are dropped at the next init
+        if (!worldSized) {
+            recordPath.swap(pendingRecordPath);
+            recordChecksums = pendingRecordChecksums;
+        }
+    }
+
+    // the log replays against the size it was recorded at
+    if (worldSized && isRecording() && (width != worldScreenWidth || height != worldScreenHeight)) {
+        LOGE("screen resized to %dx%d, input recording stopped", width, height);
+        stopRecording();
+    }
+
+    setupWorld(width, height);
+    worldScreenWidth = width;
+    worldScreenHeight = height;
+
+    if (!worldSized) {
+        worldSized = true;
+        // start the clock (and the recording) at the first tick with a sized world
+        resetGameTime();
+        if (!recordPath.empty() && !startRecording(recordPath.c_str(), recordChecksums)) {
+            LOGE("could not record input to %s", recordPath.c_str());
+        }
+    }
+}
+
 static void runGameLoop() {
+    TRACE_THREAD_NAME("game");
+
     // setup time based variables
-    struct timespec res;
-    clock_gettime(CLOCK_MONOTONIC, &res);
-    prevTimeFPS = res;
-    prevTimeUPS = res;
-    prevTimeSPS = res;
-    curTime = res;
-    startTime = res;
+    prevTimeFPS = getGameTime();
+    resetGameTime();
+
+
+    while (true) {
+        EngineState state = engineState.load(std::memory_order_acquire);
+
+        if (state == EngineState::STOPPING) {
+            break;
+        }
 
+        if (state == EngineState::PAUSED) {
+            // time stands still while paused (blocked on the condition variable, no cpu used)
+            freezeGameTime();
+            logSchedulerStats();
 
-    while (running) {
-        if (!openGLReady) {
+            if (waitForEngine() == EngineState::RUNNING) {
+                thawGameTime();
+            }
             continue;
         }
-        // call mutex conditions to pause thread when game is closed
-        std::lock_guard<std::mutex> lock(pauseMutex);
 
+        if (state == EngineState::CREATED) {
+            // nothing to tick until the opengl objects exist
+            if (waitForEngine() == EngineState::RUNNING) {
+                resetGameTime();
+            }
+            continue;
+        }
+
+        applyScreenSize();
+        if (!worldSized) {
+            // waiting on setupScreen, the next engine command or input wakes us
+            tickScheduler.waitUntil(getNextTickTime());
+            continue;
+        }
 
         // @TODO check if there is an issue here when game runs slower than render
         processInput();
-        processRawInput();
 
         updateGame();
+        publishTelemetry();
+        publishPointers();
 
         // rendering is externally called
-//        updateTime();
 
         // print any errors which may have occurred
         printGLErrors();
 
+        // sleep until the next tick is due, new input and engine commands wake us early
+        tickScheduler.waitUntil(getNextTickTime());
     }
 }
 
 static void shutdown() {
-    running = false;
+    sendEngineCommand(EngineCommand::STOP);
     gameLoop.join();
 
+    // flush the input log now the game thread is done writing it
+    stopRecording();
+
+    logSchedulerStats();
+
+    shutdownGame();
+
 
     // @TODO kill program shaders etc (may not be necessary since OS just cleans this up)
-    glDeleteProgram(program);
+    program.reset();
+    instancedProgram.reset();
+    aabbProgram.reset();
 }
 
 extern "C" {
@@ -863,11 +842,27 @@ JNIEXPORT void JNICALL Java_xyz_velvetmilk_boyboyemulator_BBoyJNILib_init(JNIEnv
     initProgram();
 }
 
+JNIEXPORT void JNICALL Java_xyz_velvetmilk_boyboyemulator_BBoyJNILib_startRecording(JNIEnv *env,
+                                                                                    jclass obj,
+                                                                                    jstring path,
+                                                                                    jboolean checksums) {
+    LOGV(__FUNCTION__, "startRecording");
+
+    // the log is opened on the game thread right before the first tick (the header needs the world size)
+    const char* recordPath = env->GetStringUTFChars(path, nullptr);
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        pendingRecordPath = recordPath;
+        pendingRecordChecksums = static_cast<bool>(checksums);
+    }
+    env->ReleaseStringUTFChars(path, recordPath);
+}
+
 JNIEXPORT void JNICALL Java_xyz_velvetmilk_boyboyemulator_BBoyJNILib_run(JNIEnv *env,
                                                                          jclass obj) {
     LOGV(__FUNCTION__, "init");
 
-    running = true;
+    sendEngineCommand(EngineCommand::START);
     gameLoop = std::thread(runGameLoop);
 }
 
@@ -877,8 +872,12 @@ JNIEXPORT jboolean JNICALL Java_xyz_velvetmilk_boyboyemulator_BBoyJNILib_initOpe
 
     printCurrentThread("opengl init");
 
-    bool success = initOpenGL();
-    initOpenGLObjects();
+    bool success = initOpenGL() && initOpenGLObjects();
+
+    // the programs and meshes exist now so the game loop may start ticking
+    if (success) {
+        sendEngineCommand(EngineCommand::OPENGL_READY);
+    }
 
     std::string hello = "initOpenGL";
     return jboolean(success);
@@ -940,120 +939,109 @@ JNIEXPORT void JNICALL Java_xyz_velvetmilk_boyboyemulator_BBoyJNILib_shutdown(JN
     shutdown();
 }
 
-JNIEXPORT void JNICALL Java_xyz_velvetmilk_boyboyemulator_BBoyJNILib_obtainFPS(JNIEnv *env,
-                                                                               jclass javaThis,
-                                                                               jobject obj) {
-    LOGV(__FUNCTION__, "obtainFPS");
-
-    jclass clazz = env->GetObjectClass(obj);
-
-    // Get Field references
-    jfieldID param1Field = env->GetFieldID(clazz, "fps", "F");
-    jfieldID param2Field = env->GetFieldID(clazz, "ups", "F");
-    jfieldID param3Field = env->GetFieldID(clazz, "true_ups", "F");
-    jfieldID param4Field = env->GetFieldID(clazz, "frame", "J");
-    jfieldID param5Field = env->GetFieldID(clazz, "stepped_frame", "J");
-    jfieldID param6Field = env->GetFieldID(clazz, "cur_time", "J");
-    jfieldID param7Field = env->GetFieldID(clazz, "sps", "F");
-
-    // Set fields for object
-    env->SetFloatField(obj, param1Field, fps);
-    env->SetFloatField(obj, param2Field, ups);
-    env->SetFloatField(obj, param3Field, true_ups);
-    env->SetLongField(obj, param4Field, currentFrame);
-    env->SetLongField(obj, param5Field, currentSteppedFrame);
-    env->SetLongField(obj, param6Field, curTime.tv_sec - startTime.tv_sec);
-    env->SetFloatField(obj, param7Field, sps);
-}
-
-JNIEXPORT jobjectArray JNICALL Java_xyz_velvetmilk_boyboyemulator_BBoyJNILib_obtainPos(JNIEnv *env,
-                                                                               jclass javaThis) {
-    LOGV(__FUNCTION__, "obtainFPS");
-
-    unsigned long positionListSize = curPositionList.size();
-
-    jclass clazz = env->FindClass("xyz/velvetmilk/boyboyemulator/BBoyInputEvent");
-    jmethodID constructor = env->GetMethodID(clazz, "<init>", "()V");
-    jobjectArray retArray = env->NewObjectArray(static_cast<jsize>(positionListSize), clazz, nullptr);
-
-    for (int i = 0; i < positionListSize; ++i) {
-        jobject newObj = env->NewObject(clazz, constructor);
+JNIEXPORT jobject JNICALL Java_xyz_velvetmilk_boyboyemulator_BBoyJNILib_obtainTelemetry(JNIEnv *env,
+                                                                                     jclass javaThis) {
+    LOGV(__FUNCTION__, "obtainTelemetry");
 
-        // Get Field references
-        jfieldID param1Field = env->GetFieldID(clazz, "x", "F");
-        jfieldID param2Field = env->GetFieldID(clazz, "y", "F");
-        jfieldID param3Field = env->GetFieldID(clazz, "normX", "F");
-        jfieldID param4Field = env->GetFieldID(clazz, "normY", "F");
-
-        // Set fields for object
-        env->SetFloatField(newObj, param1Field, rawPositionList[i].x);
-        env->SetFloatField(newObj, param2Field, rawPositionList[i].y);
-
-//    struct EventItem converted = convertWorldCoordToScreenCoord(curPosition);
-//    env->SetFloatField(obj, param1Field, converted.x);
-//    env->SetFloatField(obj, param2Field, converted.y);
-
-        env->SetFloatField(newObj, param3Field, curPositionList[i].x);
-        env->SetFloatField(newObj, param4Field, curPositionList[i].y);
+    // the block lives as long as the library so the buffer can be kept forever
+    return env->NewDirectByteBuffer(&telemetry, sizeof(telemetry));
+}
 
-        env->SetObjectArrayElement(retArray, i, newObj);
-    }
+JNIEXPORT void JNICALL Java_xyz_velvetmilk_boyboyemulator_BBoyJNILib_startTrace(JNIEnv *env,
+                                                                                jclass obj) {
+    LOGV(__FUNCTION__, "startTrace");
 
-    return retArray;
+    Trace::start();
 }
 
-JNIEXPORT void JNICALL Java_xyz_velvetmilk_boyboyemulator_BBoyJNILib_obtainPosInplace(JNIEnv *env,
-                                                                                       jclass javaThis,
-                                                                                       jobjectArray objArray) {
-    LOGV(__FUNCTION__, "obtainFPSInplace");
+JNIEXPORT jboolean JNICALL Java_xyz_velvetmilk_boyboyemulator_BBoyJNILib_stopTrace(JNIEnv *env,
+                                                                                   jclass obj,
+                                                                                   jstring path) {
+    LOGV(__FUNCTION__, "stopTrace");
 
-    unsigned long positionListSize = curPositionList.size();
+    Trace::stop();
 
-    jclass clazz = env->FindClass("xyz/velvetmilk/boyboyemulator/BBoyInputEvent");
+    const char* tracePath = env->GetStringUTFChars(path, nullptr);
+    bool success = Trace::exportJson(tracePath);
+    env->ReleaseStringUTFChars(path, tracePath);
 
-    for (int i = 0; i < positionListSize; ++i) {
+    return jboolean(success);
+}
 
-        // Get Field references
-        jfieldID param1Field = env->GetFieldID(clazz, "x", "F");
-        jfieldID param2Field = env->GetFieldID(clazz, "y", "F");
-        jfieldID param3Field = env->GetFieldID(clazz, "normX", "F");
-        jfieldID param4Field = env->GetFieldID(clazz, "normY", "F");
+JNIEXPORT void JNICALL Java_xyz_velvetmilk_boyboyemulator_BBoyJNILib_obtainTimings(JNIEnv *env,
+                                                                                   jclass javaThis,
+                                                                                   jlongArray timings) {
+    LOGV(__FUNCTION__, "obtainTimings");
+
+    int64_t now = Clock::monotonicNow();
+    GameTimings gameTimings = getGameTimings();
+    HistogramSummary summaries[] = {
+            frameTimes.getSummary(now),
+            renderTimes.getSummary(now),
+            gameTimings.tickTime,
+            gameTimings.stepsPerUpdate,
+    };
+
+    // count, p50, p90, p99, max of each summary in turn
+    jlong values[sizeof(summaries) / sizeof(summaries[0]) * 5];
+    jsize size = 0;
+    for (auto const& summary : summaries) {
+        values[size++] = static_cast<jlong>(summary.count);
+        values[size++] = summary.p50;
+        values[size++] = summary.p90;
+        values[size++] = summary.p99;
+        values[size++] = summary.max;
+    }
 
-        // load memory already provided
-        jobject curElement = env->GetObjectArrayElement(objArray, i);
-        env->SetFloatField(curElement, param1Field, rawPositionList[i].x);
-        env->SetFloatField(curElement, param2Field, rawPositionList[i].y);
-        env->SetFloatField(curElement, param3Field, curPositionList[i].x);
-        env->SetFloatField(curElement, param4Field, curPositionList[i].y);
-        env->SetObjectArrayElement(objArray, i, curElement);
+    if (env->GetArrayLength(timings) < size) {
+        LOGE("obtainTimings needs room for %d values", size);
+        return;
     }
+    env->SetLongArrayRegion(timings, 0, size, values);
 }
 
-JNIEXPORT void JNICALL Java_xyz_velvetmilk_boyboyemulator_BBoyJNILib_sendEvent(JNIEnv *env,
-                                                                               jclass javaThis,
-                                                                               jobjectArray objArray) {
-    LOGV(__FUNCTION__, "sendEvent");
-
-    std::vector<struct EventItem> eventList;
+JNIEXPORT jobject JNICALL Java_xyz_velvetmilk_boyboyemulator_BBoyJNILib_obtainPointers(JNIEnv *env,
+                                                                                    jclass javaThis) {
+    LOGV(__FUNCTION__, "obtainPointers");
 
-    jsize length = env->GetArrayLength(objArray);
-    for (int i = 0; i < length; ++i) {
-        jobject obj = env->GetObjectArrayElement(objArray, i);
-        jclass clazz = env->GetObjectClass(obj);
+    return env->NewDirectByteBuffer(&pointers, sizeof(pointers));
+}
 
-        // Get Field references
-        jfieldID param1Field = env->GetFieldID(clazz, "x", "F");
-        jfieldID param2Field = env->GetFieldID(clazz, "y", "F");
+JNIEXPORT void JNICALL Java_xyz_velvetmilk_boyboyemulator_BBoyJNILib_sendEvents(JNIEnv *env,
+                                                                                jclass javaThis,
+                                                                                jfloatArray positions,
+                                                                                jintArray pointerIds,
+                                                                                jlongArray timestamps,
+                                                                                jint frameCount,
+                                                                                jint pointerCount) {
+    LOGV(__FUNCTION__, "sendEvents");
 
-        // Set fields for object
-        jfloat x = env->GetFloatField(obj, param1Field);
-        jfloat y = env->GetFloatField(obj, param2Field);
+    if (frameCount <= 0 || pointerCount <= 0) {
+        return;
+    }
+    if (env->GetArrayLength(positions) < frameCount * pointerCount * 2 || env->GetArrayLength(pointerIds) < pointerCount ||
+        env->GetArrayLength(timestamps) < frameCount) {
+        LOGE("sendEvents arrays are too short for %d frames of %d pointers", frameCount, pointerCount);
+        return;
+    }
 
-        // convert jobject to struct EventItem
-        eventList.emplace_back(x, y);
+    // critical access pins (or at worst copies) the arrays, nothing in between may call back into java
+    auto positionData = static_cast<float *>(env->GetPrimitiveArrayCritical(positions, nullptr));
+    auto idData = static_cast<jint *>(env->GetPrimitiveArrayCritical(pointerIds, nullptr));
+    auto timestampData = static_cast<jlong *>(env->GetPrimitiveArrayCritical(timestamps, nullptr));
+    if (positionData != nullptr && idData != nullptr && timestampData != nullptr) {
+        storeEvents(positionData, idData, timestampData, static_cast<size_t>(frameCount), static_cast<size_t>(pointerCount));
+    }
+    if (timestampData != nullptr) {
+        env->ReleasePrimitiveArrayCritical(timestamps, timestampData, JNI_ABORT);
     }
-    // object class is a MotionEvent
-    // store event into input buffer
-    storeEvent(eventList);
+    if (idData != nullptr) {
+        env->ReleasePrimitiveArrayCritical(pointerIds, idData, JNI_ABORT);
+    }
+    if (positionData != nullptr) {
+        env->ReleasePrimitiveArrayCritical(positions, positionData, JNI_ABORT);
+    }
+
+    tickScheduler.notify();
 }
 }
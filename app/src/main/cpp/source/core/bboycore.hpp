@@ -1,16 +1,46 @@
 #ifndef BBOYCORE_H
 #define BBOYCORE_H
 
-#include <jni.h>
 #include <string>
+
+#ifndef BBOY_HEADLESS
+#include <jni.h>
 #include <android/log.h>
+#else
+#include <cstdio>
+#include <cstdarg>
+#endif
 
-#include <GLES3/gl32.h>
-#include <GLES3/gl3ext.h>
+#include "bboygl.hpp"
 
 #define LOG_TAG "libbboycore"
 
+#ifndef DEBUG
 #define DEBUG true
+#endif
+
+#ifdef BBOY_HEADLESS
+// route logging to stderr (debug and verbose output is dropped to keep bulk runs quiet)
+inline void headlessLog(const char *level, const char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    fprintf(stderr, "%s/%s: ", level, LOG_TAG);
+    vfprintf(stderr, fmt, args);
+    fputc('\n', stderr);
+    va_end(args);
+}
+
+#if DEBUG
+    #define LOGI(...) headlessLog("I", __VA_ARGS__)
+    #define LOGE(...) headlessLog("E", __VA_ARGS__)
+#else
+    #define LOGI(...)
+    #define LOGE(...)
+#endif
+#define LOGD(...)
+#define LOGV(...)
+#define LOGA(...) headlessLog("I", __VA_ARGS__)
+#else
 #if DEBUG
     #define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
     #define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
@@ -23,6 +53,7 @@
     #define LOGV(...)
 #endif
 #define LOGA(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
+#endif
 
 
 #define TIME_STEP 120
@@ -33,10 +64,32 @@
 #define BILLION_FLOAT 1000000000.0f
 #define M_PI_FLOAT 3.14159265358979323846f
 #define WORLD_SIZE 100
+#define GRID_CELL_SIZE (WORLD_SIZE / 25.0f)
+// entities per job system chunk
+#define JOB_GRAIN_SIZE 1024
 
 #define MAX_POINTER_SIZE 10
+// touch frames buffered between the UI and game threads
+#define INPUT_RING_SIZE 64
+// touch frames kept on the game thread to resample pointers at tick time
+#define INPUT_HISTORY_SIZE 8
+// how far past the newest touch sample pointers may be extrapolated
+#define INPUT_MAX_PREDICTION_NS 8000000
+// samples further apart than this are not blended together
+#define INPUT_MAX_SAMPLE_GAP_NS 50000000
+// the game loop spins (instead of sleeping) for the last part of each tick wait
+#define TICK_SPIN_NS 500000
+// timing histograms cover a rolling window of TIMING_SLICE_COUNT slices of TIMING_SLICE_NS each
+#define TIMING_SLICE_NS 1000000000
+#define TIMING_SLICE_COUNT 5
 
 #define POS_ATTRIB 0
+// instanced program only (the model matrix takes MODEL_ATTRIB to MODEL_ATTRIB + 3)
+#define COLOR_ATTRIB 1
+#define MODEL_ATTRIB 2
+// aabb overlay program only
+#define BOUNDS_MIN_ATTRIB 0
+#define BOUNDS_MAX_ATTRIB 1
 
 #define DOT_RADIUS 1.0f
 
@@ -47,6 +100,9 @@ struct EventItem {
     float y;
 };
 
+// input batches are converted as flat (x, y) float arrays
+static_assert(sizeof(EventItem) == 2 * sizeof(float), "EventItem must be two packed floats");
+
 bool checkGLError(const char *funcName);
 void printGLErrors();
 void printGLString(const char *name, GLenum s);
@@ -58,10 +114,12 @@ GLuint createShader(GLenum shaderType, const char *src);
 GLuint createProgram(const char *vtxSrc, const char *fragSrc);
 
 
+#ifndef BBOY_HEADLESS
 extern "C" {
     JNIEXPORT void JNICALL Java_xyz_velvetmilk_boyboyemulator_BBoyJNILib_init(JNIEnv *, jclass);
     JNIEXPORT jboolean JNICALL Java_xyz_velvetmilk_boyboyemulator_BBoyJNILib_initOpenGL(JNIEnv *, jclass);
     JNIEXPORT void JNICALL Java_xyz_velvetmilk_boyboyemulator_BBoyJNILib_setup(JNIEnv *, jclass, jint, jint);
+    JNIEXPORT void JNICALL Java_xyz_velvetmilk_boyboyemulator_BBoyJNILib_startRecording(JNIEnv *, jclass, jstring, jboolean);
     JNIEXPORT void JNICALL Java_xyz_velvetmilk_boyboyemulator_BBoyJNILib_run(JNIEnv *, jclass);
     JNIEXPORT void JNICALL Java_xyz_velvetmilk_boyboyemulator_BBoyJNILib_render(JNIEnv *, jclass);
     JNIEXPORT void JNICALL Java_xyz_velvetmilk_boyboyemulator_BBoyJNILib_resume(JNIEnv *, jclass);
@@ -69,10 +127,13 @@ extern "C" {
     JNIEXPORT void JNICALL Java_xyz_velvetmilk_boyboyemulator_BBoyJNILib_resumeEngine(JNIEnv *, jclass);
     JNIEXPORT void JNICALL Java_xyz_velvetmilk_boyboyemulator_BBoyJNILib_pauseEngine(JNIEnv *, jclass);
     JNIEXPORT void JNICALL Java_xyz_velvetmilk_boyboyemulator_BBoyJNILib_shutdown(JNIEnv *, jclass);
-    JNIEXPORT void JNICALL Java_xyz_velvetmilk_boyboyemulator_BBoyJNILib_obtainFPS(JNIEnv *, jclass, jobject);
-    JNIEXPORT jobjectArray JNICALL Java_xyz_velvetmilk_boyboyemulator_BBoyJNILib_obtainPos(JNIEnv *, jclass);
-    JNIEXPORT void JNICALL Java_xyz_velvetmilk_boyboyemulator_BBoyJNILib_obtainPosInplace(JNIEnv *, jclass, jobjectArray);
-    JNIEXPORT void JNICALL Java_xyz_velvetmilk_boyboyemulator_BBoyJNILib_sendEvent(JNIEnv *, jclass, jobjectArray);
+    JNIEXPORT jobject JNICALL Java_xyz_velvetmilk_boyboyemulator_BBoyJNILib_obtainTelemetry(JNIEnv *, jclass);
+    JNIEXPORT void JNICALL Java_xyz_velvetmilk_boyboyemulator_BBoyJNILib_obtainTimings(JNIEnv *, jclass, jlongArray);
+    JNIEXPORT void JNICALL Java_xyz_velvetmilk_boyboyemulator_BBoyJNILib_startTrace(JNIEnv *, jclass);
+    JNIEXPORT jboolean JNICALL Java_xyz_velvetmilk_boyboyemulator_BBoyJNILib_stopTrace(JNIEnv *, jclass, jstring);
+    JNIEXPORT jobject JNICALL Java_xyz_velvetmilk_boyboyemulator_BBoyJNILib_obtainPointers(JNIEnv *, jclass);
+    JNIEXPORT void JNICALL Java_xyz_velvetmilk_boyboyemulator_BBoyJNILib_sendEvents(JNIEnv *, jclass, jfloatArray, jintArray, jlongArray, jint, jint);
 }
+#endif
 
 #endif
@@ -0,0 +1,891 @@
+//
+// Created by Victor Zhang on 17/10/26.
+//
+#define GLM_ENABLE_EXPERIMENTAL
+
+#include <cmath>
+#include <ctime>
+#include <random>
+#include <memory>
+#include <algorithm>
+
+#include <glm/ext.hpp>
+#include <glm/glm.hpp>
+
+#include "tools/tools.hpp"
+#include "tools/JobSystem.hpp"
+#include "tools/SeqRing.hpp"
+#include "tools/TripleBuffer.hpp"
+#include "tools/Clock.hpp"
+#include "tools/InputLog.hpp"
+#include "tools/Histogram.hpp"
+#include "tools/Trace.hpp"
+#include "shapes/Quad.hpp"
+#include "shapes/SweepAndPrune.hpp"
+#include "shapes/UniformGrid.hpp"
+#include "shapes/AABBTree.hpp"
+#include "shapes/World.hpp"
+#include "shapes/BitSet.hpp"
+
+#include "bboygame.hpp"
+
+
+// ===== simulation state =====
+static int yeeNum;
+static float bgColor;
+
+static int64_t prevTimeUPS;
+static int64_t prevTimeSPS;
+// game clock time the engine was frozen at
+static int64_t freezeTime;
+static bool paused;
+static float colorUpdate;
+
+static float sps;
+static float ups;
+static float true_ups;
+
+// tail latency (the moving averages above hide hitches)
+static RollingHistogram tickTimes(TIMING_SLICE_NS, TIMING_SLICE_COUNT);
+static RollingHistogram stepsPerUpdate(TIMING_SLICE_NS, TIMING_SLICE_COUNT);
+
+static int screenWidth;
+static int screenHeight;
+
+static float worldWidth;
+static float worldHeight;
+
+// NOTE: Probably remove current position list off to be NOT lingering
+static std::vector<struct EventItem> curPositionList;
+static std::vector<struct EventItem> rawPositionList;
+
+// touch frames from the UI thread (newest frames win if the game thread falls behind)
+static SeqRing<TouchFrame, INPUT_RING_SIZE> inputBuffer;
+
+// most recent touch frames (ring, inputHistoryNext is the next slot to write)
+static TouchFrame inputHistory[INPUT_HISTORY_SIZE];
+static size_t inputHistoryNext;
+static size_t inputHistoryCount;
+
+static World world;
+
+// workers shared by the update and collision phases
+static std::unique_ptr<JobSystem> jobSystem;
+
+// every game time is read from here (nanoseconds)
+static Clock gameClock;
+static int64_t startTime;
+static int64_t curTime;
+// tick n falls due at tickOrigin + n * BILLION / TIME_STEP (exact, so nothing drifts over long sessions)
+static int64_t tickOrigin;
+static uint64_t tickIndex;
+static int64_t lastTickTime;
+
+// render state handed to the renderer thread
+static TripleBuffer<RenderSnapshot> renderSnapshots;
+// world state from before the latest step (the renderer blends from here)
+static std::vector<glm::vec3> prevTranslations;
+static std::vector<glm::quat> prevRotations;
+static std::vector<glm::vec3> prevScales;
+static std::vector<AABB> prevBounds;
+static float prevBgColor;
+
+static uint64_t currentFrame;
+static uint64_t currentSteppedFrame;
+
+static std::mt19937 rng;
+
+static Entity originPoint;
+static Entity childObject;
+static Entity pointerList[MAX_POINTER_SIZE];
+
+static Entity puckObject;
+static Entity player1Object;
+static Entity player2Object;
+
+// extra bodies spawned for stress testing live from this slot onwards (bounce around the world bounds)
+static uint32_t firstSpawnedSlot;
+static uint32_t spawnedCount;
+
+// seed the rng started from (recorded so a session can be rebuilt)
+static uint32_t gameSeed;
+
+// input recording and replay
+static InputLog inputLog;
+static uint64_t replayChecksum;
+static uint64_t replayDivergences;
+
+// collision broadphase (scratch buffers are kept to avoid per step allocations)
+static BroadphaseType broadphaseType = BroadphaseType::UNIFORM_GRID;
+static SweepAndPrune sweepAndPrune;
+static UniformGrid uniformGrid;
+static AABBTree aabbTree;
+static float gridCellSize = GRID_CELL_SIZE;
+static std::vector<uint32_t> collisionObjects;
+static std::vector<AABB> collisionBounds;
+static std::vector<std::pair<uint32_t, uint32_t>> collisionPairs;
+// slots which collided this step
+static BitSet collidedObjects;
+// =========================
+
+// normalization formula : x between [a, b]
+// https://stats.stackexchange.com/questions/178626/how-to-normalize-data-between-1-and-1
+void convertScreenCoordToWorldCoord(struct EventItem& position) {
+    // need to -1 in width and height for 0th offset
+    float xPos = worldWidth * position.x / (screenWidth - 1) - (worldWidth / 2);
+    float yPos = worldHeight * position.y / (screenHeight - 1) - (worldHeight / 2);
+
+    // negative y ratio since screen is top to bottom while coordinates is bottom to top
+    position.x = xPos;
+    position.y = -yPos;
+}
+
+
+struct EventItem convertScreenCoordToWorldCoord(struct EventItem const& position) {
+    // need to -1 in width and height for 0th offset
+    float xPos = worldWidth * position.x / (screenWidth - 1) - (worldWidth / 2);
+    float yPos = worldHeight * position.y / (screenHeight - 1) - (worldHeight / 2);
+
+    // negative y ratio since screen is top to bottom while coordinates is bottom to top
+    return { xPos, -yPos };
+}
+
+void convertWorldCoordToScreenCoord(struct EventItem& position) {
+    // need to -1 in width and height for 0th offset
+    float xPos = (screenWidth - 1) * (position.x + worldWidth / 2) / worldWidth;
+    float yPos = (screenHeight - 1) * (position.y + worldHeight / 2) / worldHeight;
+
+    // negative y ratio since screen is top to bottom while coordinates is bottom to top
+    position.x = xPos;
+    position.y = -yPos;
+}
+
+struct EventItem convertWorldCoordToScreenCoord(struct EventItem const& position) {
+    // need to -1 in width and height for 0th offset
+    float xPos = (screenWidth - 1) * (position.x + worldWidth / 2) / worldWidth;
+    float yPos = (screenHeight - 1) * (position.y + worldHeight / 2) / worldHeight;
+
+    // negative y ratio since screen is top to bottom while coordinates is bottom to top
+    return { xPos, -yPos };
+}
+
+void initGame() {
+    LOGI("initGame");
+
+    // initialise variables
+    yeeNum = 0;
+    bgColor = 0.0f;
+
+    colorUpdate = 0.02f;
+
+    sps = 0.0f;
+    ups = 0.0f;
+    true_ups = 0.0f;
+    tickTimes.reset();
+    stepsPerUpdate.reset();
+
+    currentFrame = 0;
+    currentSteppedFrame = 0;
+
+    resetGameTime();
+
+    seedGame(std::random_device()());
+
+    jobSystem.reset(new JobSystem());
+    LOGI("job system threads: %u", jobSystem->getThreadCount());
+
+    paused = false;
+}
+
+void seedGame(uint32_t seed) {
+    gameSeed = seed;
+    rng.seed(seed);
+}
+
+static Entity createQuad(glm::vec3 translation, glm::vec3 scale, Entity parent) {
+    static const AABB quadBounds(glm::vec4(-QUAD_HALF_WIDTH, -QUAD_HALF_HEIGHT, 0.0f, 1.0f),
+                                 glm::vec4(QUAD_HALF_WIDTH, QUAD_HALF_HEIGHT, 0.0f, 1.0f));
+
+    return world.create(translation, glm::identity<glm::quat>(), scale, quadBounds, MeshType::QUAD, parent);
+}
+
+void initGameObjects() {
+    // drop any objects from a previous surface
+    world.clear();
+
+    for (auto& item : pointerList) {
+        item = createQuad(glm::vec3(0.0f), glm::vec3(1.0f), WORLD_NULL_ENTITY);
+    }
+
+    // create puck and two handles
+    puckObject = createQuad(glm::vec3(0.0f), glm::vec3(1.0f), WORLD_NULL_ENTITY);
+    world.velocities[puckObject.index] = glm::vec3(0.05f, 0.05f, 0.0f);
+    player1Object = createQuad(glm::vec3(0.0f), glm::vec3(1.0f), WORLD_NULL_ENTITY);
+    player2Object = createQuad(glm::vec3(0.0f), glm::vec3(1.0f), WORLD_NULL_ENTITY);
+
+    // origin point with a child hanging off it
+    originPoint = createQuad(glm::vec3(0, 10, 0), glm::vec3(1.0f), WORLD_NULL_ENTITY);
+    childObject = createQuad(glm::vec3(10, 0, 0), glm::vec3(1.0f), originPoint);
+
+    firstSpawnedSlot = static_cast<uint32_t>(world.size());
+    spawnedCount = 0;
+}
+
+void spawnGameObjects(int count) {
+    std::uniform_real_distribution<float> rngX(-worldWidth / 2, worldWidth / 2);
+    std::uniform_real_distribution<float> rngY(-worldHeight / 2, worldHeight / 2);
+    std::uniform_real_distribution<float> rngVel(-0.05f, 0.05f);
+
+    for (int i = 0; i < count; ++i) {
+        // evaluate in a fixed order so seeded runs are reproducible
+        float x = rngX(rng);
+        float y = rngY(rng);
+        Entity entity = createQuad(glm::vec3(x, y, 0.0f), glm::vec3(0.25f, 0.25f, 1.0f), WORLD_NULL_ENTITY);
+
+        float vx = rngVel(rng);
+        float vy = rngVel(rng);
+        world.velocities[entity.index] = glm::vec3(vx, vy, 0.0f);
+    }
+
+    spawnedCount += static_cast<uint32_t>(std::max(count, 0));
+}
+
+void setupWorld(int w, int h) {
+    screenWidth = w;
+    screenHeight = h;
+
+    // get ratio
+    float aspectRatio = static_cast<float>(w) / static_cast<float>(h);
+    if (aspectRatio >= 1.0f) {
+        worldHeight = WORLD_SIZE / aspectRatio;
+        worldWidth = WORLD_SIZE;
+    } else {
+        worldHeight = WORLD_SIZE;
+        worldWidth = WORLD_SIZE * aspectRatio;
+    }
+
+    // grid covers the visible playfield
+    uniformGrid.resize(worldWidth, worldHeight, gridCellSize);
+}
+
+void setBroadphase(BroadphaseType type) {
+    broadphaseType = type;
+}
+
+void setGridCellSize(float cellSize) {
+    gridCellSize = cellSize;
+    uniformGrid.resize(worldWidth, worldHeight, gridCellSize);
+}
+
+void setClockType(ClockType type) {
+    gameClock.setType(type);
+    resetGameTime();
+}
+
+void advanceGameClock(int64_t nanoseconds) {
+    gameClock.advance(nanoseconds);
+}
+
+void advanceGameClockTo(int64_t time) {
+    gameClock.advanceTo(time);
+}
+
+bool startRecording(const char* path, bool checksums) {
+    InputLogHeader header;
+    header.seed = gameSeed;
+    header.screenWidth = screenWidth;
+    header.screenHeight = screenHeight;
+    header.spawnCount = spawnedCount;
+    header.checksums = checksums;
+
+    if (!inputLog.openWrite(path, header)) {
+        return false;
+    }
+
+    LOGI("recording input to %s (seed %u)", path, gameSeed);
+    return true;
+}
+
+void stopRecording() {
+    if (!inputLog.isWriting()) {
+        return;
+    }
+
+    LOGI("recorded %llu ticks", static_cast<unsigned long long>(inputLog.getTicks()));
+    inputLog.close();
+}
+
+bool isRecording() {
+    return inputLog.isWriting();
+}
+
+bool startReplay(const char* path) {
+    InputLogHeader header;
+    if (!inputLog.openRead(path, header)) {
+        return false;
+    }
+
+    // rebuild the world exactly as it was when recording started
+    seedGame(header.seed);
+    setupWorld(header.screenWidth, header.screenHeight);
+    initGameObjects();
+    spawnGameObjects(static_cast<int>(header.spawnCount));
+
+    replayDivergences = 0;
+
+    LOGI("replaying input from %s (seed %u)", path, header.seed);
+    return true;
+}
+
+bool isReplaying() {
+    return inputLog.isReading();
+}
+
+uint64_t getReplayDivergences() {
+    return replayDivergences;
+}
+
+void setWorkerCount(int count) {
+    jobSystem.reset(new JobSystem(static_cast<unsigned>(std::max(count, 0))));
+}
+
+void shutdownGame() {
+    stopRecording();
+    inputLog.close();
+    sweepAndPrune.clear();
+    aabbTree.clear();
+    world.clear();
+    jobSystem.reset();
+}
+
+// bounds of active objects packed for the grid broadphase (it rebuilds from scratch every tick)
+static void gatherCollisionBounds() {
+    collisionObjects.clear();
+    collisionBounds.clear();
+    for (uint32_t i = 0; i < world.size(); ++i) {
+        // skip for inactive objects
+        if (!world.active[i]) {
+            continue;
+        }
+        collisionObjects.emplace_back(i);
+        collisionBounds.emplace_back(world.bounds[i]);
+    }
+}
+
+// packed list indices back to slots
+static void mapCollisionPairs() {
+    for (auto& pair : collisionPairs) {
+        pair.first = collisionObjects[pair.first];
+        pair.second = collisionObjects[pair.second];
+    }
+}
+
+static TouchFrame const& recentInput(size_t age) {
+    return inputHistory[(inputHistoryNext + INPUT_HISTORY_SIZE - 1 - age) % INPUT_HISTORY_SIZE];
+}
+
+static bool canBlendInput(TouchFrame const& a, TouchFrame const& b) {
+    return b.timestamp > a.timestamp && b.timestamp - a.timestamp <= INPUT_MAX_SAMPLE_GAP_NS;
+}
+
+// index of pointer id in frame, or frame.count if that finger was not down
+static uint32_t findPointer(TouchFrame const& frame, int32_t id) {
+    uint32_t i = 0;
+    while (i < frame.count && frame.ids[i] != id) {
+        ++i;
+    }
+    return i;
+}
+
+// place the pointers where the touch was at tickTime instead of wherever the newest frame happened to be
+static void resampleInput(int64_t tickTime) {
+    if (inputHistoryCount == 0) {
+        return;
+    }
+
+    TouchFrame const* from = nullptr;
+    TouchFrame const* to = &recentInput(0);
+
+    if (tickTime >= to->timestamp) {
+        // ahead of the newest sample, extrapolate from the last two for a little while
+        if (inputHistoryCount >= 2 && tickTime - to->timestamp <= INPUT_MAX_PREDICTION_NS) {
+            from = &recentInput(1);
+        }
+    } else {
+        // behind the newest sample, find the two samples around the tick (or hold the oldest one)
+        to = &recentInput(inputHistoryCount - 1);
+        for (size_t age = 1; age < inputHistoryCount; ++age) {
+            if (recentInput(age).timestamp <= tickTime) {
+                from = &recentInput(age);
+                to = &recentInput(age - 1);
+                break;
+            }
+        }
+    }
+
+    curPositionList.resize(to->count);
+    rawPositionList.resize(to->count);
+
+    if (from == nullptr || !canBlendInput(*from, *to)) {
+        std::copy(to->world, to->world + to->count, curPositionList.begin());
+        std::copy(to->raw, to->raw + to->count, rawPositionList.begin());
+        return;
+    }
+
+    // fingers are matched by pointer id, one that just went down holds its newest position
+    float alpha = static_cast<float>(tickTime - from->timestamp) / static_cast<float>(to->timestamp - from->timestamp);
+    for (uint32_t i = 0; i < to->count; ++i) {
+        uint32_t j = findPointer(*from, to->ids[i]);
+        if (j == from->count) {
+            curPositionList[i] = to->world[i];
+            rawPositionList[i] = to->raw[i];
+            continue;
+        }
+
+        curPositionList[i].x = from->world[j].x + (to->world[i].x - from->world[j].x) * alpha;
+        curPositionList[i].y = from->world[j].y + (to->world[i].y - from->world[j].y) * alpha;
+        rawPositionList[i].x = from->raw[j].x + (to->raw[i].x - from->raw[j].x) * alpha;
+        rawPositionList[i].y = from->raw[j].y + (to->raw[i].y - from->raw[j].y) * alpha;
+    }
+}
+
+// inverse of convertScreenCoordsToWorldCoords (the y axis flips back to top to bottom)
+static void convertWorldCoordsToScreenCoords(float const* world, float* screen, size_t count) {
+    float scaleX = (screenWidth - 1) / worldWidth;
+    float scaleY = -(screenHeight - 1) / worldHeight;
+    float offsetX = worldWidth / 2;
+    float offsetY = worldHeight / 2;
+
+    for (size_t i = 0; i < count; ++i) {
+        screen[i * 2] = (world[i * 2] + offsetX) * scaleX;
+        screen[i * 2 + 1] = (world[i * 2 + 1] - offsetY) * scaleY;
+    }
+}
+
+// take the pointers from the replay log instead of the live input
+static bool replayInput() {
+    struct EventItem positions[MAX_POINTER_SIZE];
+    uint32_t count = 0;
+    if (!inputLog.readTick(positions, count, replayChecksum)) {
+        LOGE("replay log ended early after %llu ticks", static_cast<unsigned long long>(inputLog.getTicks()));
+        return false;
+    }
+
+    curPositionList.assign(positions, positions + count);
+    rawPositionList.resize(count);
+    if (count > 0) {
+        convertWorldCoordsToScreenCoords(&curPositionList[0].x, &rawPositionList[0].x, count);
+    }
+    return true;
+}
+
+void stepGame(int64_t tickTime) {
+    TRACE_ZONE("stepGame");
+
+    currentSteppedFrame++;
+
+    bool replayed = inputLog.isReading() && replayInput();
+    if (!replayed) {
+        resampleInput(tickTime);
+    }
+
+    yeeNum++;
+    yeeNum %= TIME_STEP;
+
+    // increase vs decrease color
+    bgColor += colorUpdate;
+
+    // toggle color
+    if (bgColor > 1.0f) {
+        colorUpdate = -1.0f * MS_PER_UPDATE / 2;
+    }
+
+    if (bgColor < 0.0f) {
+        colorUpdate = +1.0f * MS_PER_UPDATE / 2;
+    }
+
+    // clamp bgcolor to [0, 1]
+    bgColor = glm::clamp(bgColor, 0.0f, 1.0f);
+
+    // update random position between [-20, 20]
+//    if (yeeNum == 0) {
+//        std::uniform_real_distribution<float> rngPos(-20, 20);
+//        float x = rngPos(rng);
+//        float y = rngPos(rng);
+//    }
+
+    // disable non updated pointers
+    for (auto const& item : pointerList) {
+        world.active[item.index] = 0;
+    }
+
+    // update the position of pointers
+    for (size_t i = 0; i < curPositionList.size() && i < static_cast<size_t>(MAX_POINTER_SIZE); ++i) {
+        world.setTranslation(pointerList[i], glm::vec3(curPositionList[i].x, curPositionList[i].y, 0.0f));
+        world.active[pointerList[i].index] = 1;
+    }
+
+    // update the rotation of the cool object
+    glm::quat rotation = glm::rotate(world.getRotation(originPoint), glm::radians(1.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+    world.setRotation(originPoint, glm::normalize(rotation));
+
+    // update TRS of puck and players
+    world.setTranslation(player1Object, glm::vec3(0.0f, -20.0f, 0.0f));
+    world.setTranslation(player2Object, glm::vec3(0.0f, 20.0f, 0.0f));
+
+    // update objects
+    {
+        TRACE_ZONE("integrate");
+        jobSystem->parallelFor(world.size(), JOB_GRAIN_SIZE, [](size_t begin, size_t end) {
+            world.integrate(begin, end);
+        });
+    }
+
+    // custom code for puck updating
+    glm::vec3& puckVelocity = world.velocities[puckObject.index];
+    glm::vec3 const& puckPosition = world.getTranslation(puckObject);
+    if (puckPosition.x < -worldWidth / 2 || puckPosition.x > worldWidth / 2) {
+        puckVelocity.x = -puckVelocity.x;
+    }
+
+    if (puckPosition.y < -worldHeight/ 2 || puckPosition.y > worldHeight / 2) {
+        std::uniform_real_distribution<float> rngVel(-0.05f, 0.05f);
+        float v = rngVel(rng);
+        puckVelocity = glm::vec3(v, v, 0.0f);
+        world.setTranslation(puckObject, glm::vec3(5.0f, 0.0f, 0.0f));
+    }
+
+    // bounce spawned bodies off the world bounds
+    auto slotCount = static_cast<uint32_t>(world.size());
+    std::vector<glm::vec3> const& translations = world.getTranslations();
+    for (uint32_t i = firstSpawnedSlot; i < slotCount; ++i) {
+        glm::vec3 const& position = translations[i];
+        if (position.x < -worldWidth / 2 || position.x > worldWidth / 2) {
+            world.velocities[i].x = -world.velocities[i].x;
+        }
+        if (position.y < -worldHeight / 2 || position.y > worldHeight / 2) {
+            world.velocities[i].y = -world.velocities[i].y;
+        }
+    }
+
+    // refresh world matrices and bounds of anything which moved
+    {
+        TRACE_ZONE("transforms");
+        jobSystem->parallelFor(world.size(), JOB_GRAIN_SIZE, [](size_t begin, size_t end) {
+            world.updateRootTransforms(begin, end);
+        });
+        world.finishTransforms();
+    }
+
+    // check collision (each overlapping pair of slots is reported once)
+    {
+        TRACE_ZONE("broadphase");
+        switch (broadphaseType) {
+            case BroadphaseType::SWEEP_AND_PRUNE:
+                // keeps its proxies between ticks, keyed by slot
+                sweepAndPrune.findPairs(world.bounds, world.active, collisionPairs);
+                break;
+            case BroadphaseType::UNIFORM_GRID:
+                gatherCollisionBounds();
+                uniformGrid.findPairs(collisionBounds, collisionPairs, *jobSystem);
+                mapCollisionPairs();
+                break;
+            case BroadphaseType::AABB_TREE:
+                // keeps its proxies and pairs between ticks, keyed by slot
+                aabbTree.findPairs(world.bounds, world.active, collisionPairs);
+                break;
+        }
+    }
+    collidedObjects.resize(slotCount);
+    collidedObjects.reset();
+    for (auto const& pair : collisionPairs) {
+        // flag the collided objects
+        collidedObjects.set(pair.first);
+        collidedObjects.set(pair.second);
+    }
+
+    if (collidedObjects.test(puckObject.index)) {
+        puckVelocity.y = -(puckVelocity.y * 1.1f);
+        puckVelocity.x = -(puckVelocity.x * 1.1f);
+    }
+
+    // set collided objects to a yellow color
+    for (uint32_t i = 0; i < slotCount; ++i) {
+        bool collided = collidedObjects.test(i);
+        world.colors[i] = collided ? glm::vec4(1.0f, 1.0f, 0.0f, 1.0f) : glm::vec4(0.0f, 1.0f, 0.0f, 1.0f);
+    }
+
+    if (inputLog.isWriting()) {
+        uint64_t checksum = inputLog.hasChecksums() ? world.checksum() : 0;
+        inputLog.writeTick(curPositionList.data(), static_cast<uint32_t>(curPositionList.size()), checksum);
+    } else if (replayed && inputLog.hasChecksums() && world.checksum() != replayChecksum) {
+        // only the first one is interesting, everything after follows from it
+        if (replayDivergences == 0) {
+            LOGE("replay diverged at tick %llu", static_cast<unsigned long long>(inputLog.getTicks()));
+        }
+        replayDivergences++;
+    }
+
+    if (replayed && !inputLog.isOpen()) {
+        LOGI("replay finished after %llu ticks (%llu divergent)",
+             static_cast<unsigned long long>(inputLog.getTicks()),
+             static_cast<unsigned long long>(replayDivergences));
+    }
+}
+
+static int64_t getTickTime(uint64_t index) {
+    return tickOrigin + static_cast<int64_t>(index * BILLION / TIME_STEP);
+}
+
+static void capturePreviousState() {
+    prevTranslations.assign(world.getTranslations().begin(), world.getTranslations().end());
+    prevRotations.assign(world.getRotations().begin(), world.getRotations().end());
+    prevScales.assign(world.getScales().begin(), world.getScales().end());
+    prevBounds.assign(world.bounds.begin(), world.bounds.end());
+    prevBgColor = bgColor;
+}
+
+static void publishRenderSnapshot() {
+    TRACE_ZONE("publishRenderSnapshot");
+
+    RenderSnapshot& snapshot = renderSnapshots.getBack();
+    snapshot.time = lastTickTime;
+    snapshot.prevBgColor = prevBgColor;
+    snapshot.bgColor = bgColor;
+    snapshot.worldWidth = worldWidth;
+    snapshot.worldHeight = worldHeight;
+
+    std::vector<glm::vec3> const& translations = world.getTranslations();
+    std::vector<glm::quat> const& rotations = world.getRotations();
+    std::vector<glm::vec3> const& scales = world.getScales();
+
+    // the buffers are recycled so this only allocates when the world grows
+    size_t count = world.size();
+    snapshot.items.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        RenderItem& item = snapshot.items[i];
+
+        // slots created during the step have no previous state
+        bool existed = i < prevTranslations.size();
+        item.prevTranslation = existed ? prevTranslations[i] : translations[i];
+        item.prevRotation = existed ? prevRotations[i] : rotations[i];
+        item.prevScale = existed ? prevScales[i] : scales[i];
+        item.prevBounds = existed ? prevBounds[i] : world.bounds[i];
+
+        item.translation = translations[i];
+        item.rotation = rotations[i];
+        item.scale = scales[i];
+        item.bounds = world.bounds[i];
+        item.color = world.colors[i];
+        item.parent = world.parents[i];
+        item.mesh = world.meshes[i];
+        item.active = world.active[i];
+    }
+
+    renderSnapshots.publish();
+}
+
+void resetGameTime() {
+    // setup time based variables
+    int64_t now = gameClock.now();
+    prevTimeUPS = now;
+    prevTimeSPS = now;
+    curTime = now;
+    startTime = now;
+    tickOrigin = now;
+    tickIndex = 0;
+}
+
+void freezeGameTime() {
+    freezeTime = gameClock.now();
+}
+
+void thawGameTime() {
+    // shift everything forward by however long we were frozen (no catch up ticks)
+    int64_t frozen = gameClock.now() - freezeTime;
+    prevTimeUPS += frozen;
+    prevTimeSPS += frozen;
+    tickOrigin += frozen;
+}
+
+int updateGame() {
+    TRACE_ZONE("updateGame");
+
+    // calculate time elapsed from previous update
+    int64_t now = gameClock.now();
+    float elapsed = (now - prevTimeUPS) / BILLION_FLOAT;
+
+    // update time before stepping game
+    curTime = now;
+    prevTimeUPS = now;
+
+    // num steps per update call
+    int stepCounter = 0;
+
+    // update in steps (every tick due by now, up to the frame skip limit)
+    bool stepped = false;
+    while (getTickTime(tickIndex + 1) <= now && stepCounter < MAX_FRAME_SKIP) {
+        tickIndex++;
+        if (!paused) {
+            lastTickTime = getTickTime(tickIndex);
+            capturePreviousState();
+
+            int64_t stepStart = Clock::monotonicNow();
+            stepGame(lastTickTime);
+            tickTimes.record(Clock::monotonicNow() - stepStart, stepStart);
+
+            stepped = true;
+        }
+
+        currentFrame++;
+        stepCounter++;
+    }
+
+    // only the last two ticks matter to the renderer
+    if (stepped) {
+        publishRenderSnapshot();
+    }
+
+    stepsPerUpdate.record(stepCounter, Clock::monotonicNow());
+
+    // update debug counters (a virtual clock may not have moved at all)
+    if (elapsed > 0.0f) {
+        true_ups = MOVING_AVERAGE_ALPHA * true_ups + (1.0f - MOVING_AVERAGE_ALPHA) / elapsed;
+
+        if (stepCounter > 0) {
+            ups = MOVING_AVERAGE_ALPHA * ups + (1.0f - MOVING_AVERAGE_ALPHA) * stepCounter / elapsed;
+        }
+    }
+
+    if (stepCounter > 0) {
+        float elapsedSPS = (now - prevTimeSPS) / BILLION_FLOAT;
+        if (elapsedSPS > 0.0f) {
+            sps = MOVING_AVERAGE_ALPHA * sps + (1.0f - MOVING_AVERAGE_ALPHA) * stepCounter / elapsedSPS;
+        }
+        prevTimeSPS = now;
+    }
+
+    return stepCounter;
+}
+
+void pauseGame() {
+    paused = true;
+}
+
+void resumeGame() {
+    paused = false;
+}
+
+// same mapping as convertScreenCoordToWorldCoord folded into one multiply add per axis
+// (count x, y pairs with no branches so the compiler vectorises it)
+static void convertScreenCoordsToWorldCoords(float const* screen, float* world, size_t count) {
+    float scaleX = worldWidth / (screenWidth - 1);
+    float scaleY = -worldHeight / (screenHeight - 1);
+    float offsetX = -worldWidth / 2;
+    float offsetY = worldHeight / 2;
+
+    for (size_t i = 0; i < count; ++i) {
+        world[i * 2] = screen[i * 2] * scaleX + offsetX;
+        world[i * 2 + 1] = screen[i * 2 + 1] * scaleY + offsetY;
+    }
+}
+
+void storeEvent(struct EventItem const* events, int32_t const* ids, size_t count, int64_t timestamp) {
+    TouchFrame frame;
+    frame.timestamp = timestamp;
+    frame.count = static_cast<uint32_t>(std::min<size_t>(count, MAX_POINTER_SIZE));
+    std::copy(ids, ids + frame.count, frame.ids);
+    std::copy(events, events + frame.count, frame.raw);
+
+    inputBuffer.push(frame);
+}
+
+void storeEvents(float const* positions, int32_t const* ids, int64_t const* timestamps, size_t frameCount, size_t pointerCount) {
+    TouchFrame frame;
+    frame.count = static_cast<uint32_t>(std::min<size_t>(pointerCount, MAX_POINTER_SIZE));
+    std::copy(ids, ids + frame.count, frame.ids);
+
+    for (size_t f = 0; f < frameCount; ++f) {
+        frame.timestamp = timestamps[f];
+
+        // pointers past MAX_POINTER_SIZE are dropped
+        float const* screen = positions + f * pointerCount * 2;
+        std::copy(screen, screen + frame.count * 2, &frame.raw[0].x);
+
+        inputBuffer.push(frame);
+    }
+}
+
+void processInput() {
+    TRACE_ZONE("processInput");
+
+    // drain everything, the steps pick positions out of the history by time
+    TouchFrame frame;
+    while (inputBuffer.pop(frame)) {
+        // ignore input if paused
+        if (paused) {
+            continue;
+        }
+
+        // convert android xy coords to world coords here, the world size belongs to the game thread
+        convertScreenCoordsToWorldCoords(&frame.raw[0].x, &frame.world[0].x, frame.count);
+
+        inputHistory[inputHistoryNext] = frame;
+        inputHistoryNext = (inputHistoryNext + 1) % INPUT_HISTORY_SIZE;
+        inputHistoryCount = std::min<size_t>(inputHistoryCount + 1, INPUT_HISTORY_SIZE);
+    }
+}
+
+GameStats getGameStats() {
+    GameStats stats;
+    stats.ups = ups;
+    stats.trueUps = true_ups;
+    stats.sps = sps;
+    stats.frame = currentFrame;
+    stats.steppedFrame = currentSteppedFrame;
+    stats.curTime = static_cast<long>((curTime - startTime) / BILLION);
+
+    return stats;
+}
+
+GameTimings getGameTimings() {
+    int64_t now = Clock::monotonicNow();
+
+    GameTimings timings;
+    timings.tickTime = tickTimes.getSummary(now);
+    timings.stepsPerUpdate = stepsPerUpdate.getSummary(now);
+    return timings;
+}
+
+int64_t getNextTickTime() {
+    return getTickTime(tickIndex + 1);
+}
+
+int64_t getGameTime() {
+    return gameClock.now();
+}
+
+RenderSnapshot const& getRenderSnapshot() {
+    renderSnapshots.update();
+    return renderSnapshots.getFront();
+}
+
+float getWorldWidth() {
+    return worldWidth;
+}
+
+float getWorldHeight() {
+    return worldHeight;
+}
+
+World const& getWorld() {
+    return world;
+}
+
+std::vector<struct EventItem> const& getPositionList() {
+    return curPositionList;
+}
+
+std::vector<struct EventItem> const& getRawPositionList() {
+    return rawPositionList;
+}
@@ -0,0 +1,146 @@
+//
+// Created by Victor Zhang on 17/10/26.
+//
+
+#ifndef BOYBOY_BBOYGAME_H
+#define BOYBOY_BBOYGAME_H
+
+#include <vector>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include "bboycore.hpp"
+#include "shapes/AABB.hpp"
+#include "shapes/World.hpp"
+#include "tools/Clock.hpp"
+#include "tools/Histogram.hpp"
+
+enum class BroadphaseType {
+    SWEEP_AND_PRUNE,
+    UNIFORM_GRID,
+    AABB_TREE,
+};
+
+// one touch event as it crosses from the UI thread to the game thread
+struct TouchFrame {
+    // CLOCK_MONOTONIC nanoseconds the touch was sampled at
+    int64_t timestamp;
+    uint32_t count;
+    // pointer ids stay with a finger while it is down (indices shift as other fingers lift)
+    int32_t ids[MAX_POINTER_SIZE];
+    struct EventItem raw[MAX_POINTER_SIZE];
+    // filled in by processInput (only the raw screen positions cross the ring)
+    struct EventItem world[MAX_POINTER_SIZE];
+};
+
+// state of one world slot over the last two ticks (local transforms, parent is a slot index)
+struct RenderItem {
+    glm::vec3 prevTranslation;
+    glm::vec3 translation;
+    glm::quat prevRotation;
+    glm::quat rotation;
+    glm::vec3 prevScale;
+    glm::vec3 scale;
+    AABB prevBounds;
+    AABB bounds;
+    glm::vec4 color;
+    uint32_t parent;
+    MeshType mesh;
+    uint8_t active;
+};
+
+// everything the renderer needs, published by the game thread after every update which stepped
+struct RenderSnapshot {
+    // CLOCK_MONOTONIC nanoseconds of the newest tick (the previous state is one tick older)
+    int64_t time;
+    float prevBgColor;
+    float bgColor;
+    // world extents the items were stepped in (the projection follows them)
+    float worldWidth;
+    float worldHeight;
+    std::vector<RenderItem> items;
+};
+
+struct GameStats {
+    float ups;
+    float trueUps;
+    float sps;
+    uint64_t frame;
+    uint64_t steppedFrame;
+    long curTime;
+};
+
+// tail latency of the game thread over the rolling timing window
+struct GameTimings {
+    // nanoseconds spent in each stepGame
+    HistogramSummary tickTime;
+    // ticks run per updateGame call (anything above 1 is the game catching up)
+    HistogramSummary stepsPerUpdate;
+};
+
+// simulation lifecycle (no JNI / EGL required)
+void initGame();
+void seedGame(uint32_t);
+void initGameObjects();
+void spawnGameObjects(int);
+// resize the broadphase grid, so only call these from the thread stepping the game (between ticks)
+void setupWorld(int, int);
+void setGridCellSize(float);
+void setBroadphase(BroadphaseType);
+void setWorkerCount(int);
+void shutdownGame();
+
+// game clock (switching type resets game time)
+void setClockType(ClockType);
+// virtual clock only
+void advanceGameClock(int64_t);
+void advanceGameClockTo(int64_t);
+
+// stepping
+void resetGameTime();
+void freezeGameTime();
+void thawGameTime();
+// runs every tick due by the game clock (at most MAX_FRAME_SKIP), returns the number run
+int updateGame();
+void stepGame(int64_t);
+void pauseGame();
+void resumeGame();
+
+// input recording / replay, call right after the world is set up (before the first tick)
+// a replay rebuilds the world from the log header and then feeds its pointers back tick for tick
+bool startRecording(const char*, bool);
+void stopRecording();
+bool isRecording();
+bool startReplay(const char*);
+// false once the log runs out
+bool isReplaying();
+// ticks whose world checksum did not match the recording
+uint64_t getReplayDivergences();
+
+// input
+// storeEvent(s) may only be called from a single (UI) thread, processInput from the game thread
+void storeEvent(struct EventItem const*, int32_t const*, size_t, int64_t);
+// frameCount frames of pointerCount screen (x, y) pairs each, oldest first, with one timestamp per frame
+// and one pointer id per pointer (shared by every frame)
+void storeEvents(float const*, int32_t const*, int64_t const*, size_t, size_t);
+void processInput();
+
+// state queries
+GameStats getGameStats();
+GameTimings getGameTimings();
+// game clock nanoseconds at which the next tick falls due
+int64_t getNextTickTime();
+int64_t getGameTime();
+// game thread only, the renderer takes the world size from RenderSnapshot
+float getWorldWidth();
+float getWorldHeight();
+World const& getWorld();
+std::vector<struct EventItem> const& getPositionList();
+std::vector<struct EventItem> const& getRawPositionList();
+
+// render thread only, picks up the newest published snapshot (never blocks the game thread)
+RenderSnapshot const& getRenderSnapshot();
+
+#endif //BOYBOY_BBOYGAME_H
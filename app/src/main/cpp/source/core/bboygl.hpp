@@ -0,0 +1,160 @@
+//
+// Created by Victor Zhang on 17/10/26.
+//
+
+#ifndef BOYBOY_BBOYGL_H
+#define BOYBOY_BBOYGL_H
+
+#ifndef BBOY_HEADLESS
+
+#include <GLES3/gl32.h>
+#include <GLES3/gl3ext.h>
+
+#else
+
+// headless builds (desktop simulation) have no GL context
+// so every GL entry point used by the engine compiles down to a no-op
+#include <cstddef>
+#include <cstdint>
+
+typedef unsigned int GLenum;
+typedef unsigned char GLboolean;
+typedef unsigned int GLbitfield;
+typedef int GLint;
+typedef int GLsizei;
+typedef unsigned int GLuint;
+typedef float GLfloat;
+typedef char GLchar;
+typedef unsigned char GLubyte;
+typedef std::ptrdiff_t GLsizeiptr;
+typedef std::ptrdiff_t GLintptr;
+
+#define GL_FALSE 0
+#define GL_TRUE 1
+#define GL_NO_ERROR 0
+#define GL_FLOAT 0x1406
+#define GL_UNSIGNED_INT 0x1405
+#define GL_TRIANGLES 0x0004
+#define GL_LINE_LOOP 0x0002
+#define GL_ARRAY_BUFFER 0x8892
+#define GL_ELEMENT_ARRAY_BUFFER 0x8893
+#define GL_STATIC_DRAW 0x88E4
+#define GL_DYNAMIC_DRAW 0x88E8
+#define GL_STREAM_DRAW 0x88E0
+
+inline GLenum glGetError() { return GL_NO_ERROR; }
+inline void glGenBuffers(GLsizei n, GLuint *buffers) { for (GLsizei i = 0; i < n; ++i) buffers[i] = 0; }
+inline void glGenVertexArrays(GLsizei n, GLuint *arrays) { for (GLsizei i = 0; i < n; ++i) arrays[i] = 0; }
+inline void glDeleteBuffers(GLsizei, const GLuint *) {}
+inline void glDeleteVertexArrays(GLsizei, const GLuint *) {}
+inline void glDeleteProgram(GLuint) {}
+inline void glBindBuffer(GLenum, GLuint) {}
+inline void glBindVertexArray(GLuint) {}
+inline void glBufferData(GLenum, GLsizeiptr, const void *, GLenum) {}
+inline void glBufferSubData(GLenum, GLintptr, GLsizeiptr, const void *) {}
+inline void glVertexAttribPointer(GLuint, GLint, GLenum, GLboolean, GLsizei, const void *) {}
+inline void glEnableVertexAttribArray(GLuint) {}
+inline void glVertexAttribDivisor(GLuint, GLuint) {}
+inline void glUniformMatrix4fv(GLint, GLsizei, GLboolean, const GLfloat *) {}
+inline void glUniform4fv(GLint, GLsizei, const GLfloat *) {}
+inline void glDrawElements(GLenum, GLsizei, GLenum, const void *) {}
+inline void glDrawElementsInstanced(GLenum, GLsizei, GLenum, const void *, GLsizei) {}
+inline void glDrawArraysInstanced(GLenum, GLint, GLsizei, GLsizei) {}
+inline void glDrawArrays(GLenum, GLint, GLsizei) {}
+
+#endif
+
+#include <cstdint>
+
+// bumped (render thread) whenever a new GL context is made current
+// the old context has already freed its objects by then
+inline uint32_t& glContextGeneration() {
+    static uint32_t generation = 0;
+    return generation;
+}
+
+// refills the bound per frame buffer, capacity (bytes) only ever grows
+// the old storage is orphaned so the driver does not stall on draws still reading it
+inline void streamBufferData(GLenum target, GLsizeiptr& capacity, GLsizeiptr size, const void *data) {
+    if (size > capacity) {
+        capacity = size;
+        glBufferData(target, capacity, data, GL_STREAM_DRAW);
+    } else {
+        glBufferData(target, capacity, nullptr, GL_STREAM_DRAW);
+        glBufferSubData(target, 0, size, data);
+    }
+}
+
+enum class GLObjectType : uint8_t {
+    BUFFER,
+    VERTEX_ARRAY,
+    PROGRAM,
+};
+
+// move only owner of one GL object name, deleted with the handle
+// names from an older context are dropped without a delete (they may alias objects of the new one)
+template <GLObjectType type>
+class GLHandle {
+public:
+    GLHandle() : name(0), generation(0) {}
+    explicit GLHandle(GLuint name) : name(name), generation(glContextGeneration()) {}
+    GLHandle(GLHandle&& other) noexcept : name(other.name), generation(other.generation) { other.name = 0; }
+    GLHandle& operator=(GLHandle&& other) noexcept {
+        if (this != &other) {
+            reset();
+            name = other.name;
+            generation = other.generation;
+            other.name = 0;
+        }
+        return *this;
+    }
+    GLHandle(const GLHandle&) = delete;
+    GLHandle& operator=(const GLHandle&) = delete;
+    ~GLHandle() { reset(); }
+
+    // buffers and vertex arrays only (programs are adopted from createProgram)
+    static GLHandle generate() {
+        GLuint name = 0;
+        switch (type) {
+            case GLObjectType::BUFFER:
+                glGenBuffers(1, &name);
+                break;
+            case GLObjectType::VERTEX_ARRAY:
+                glGenVertexArrays(1, &name);
+                break;
+            case GLObjectType::PROGRAM:
+                break;
+        }
+        return GLHandle(name);
+    }
+
+    GLuint get() const { return name; }
+    explicit operator bool() const { return name != 0; }
+
+    void reset() {
+        if (name != 0 && generation == glContextGeneration()) {
+            switch (type) {
+                case GLObjectType::BUFFER:
+                    glDeleteBuffers(1, &name);
+                    break;
+                case GLObjectType::VERTEX_ARRAY:
+                    glDeleteVertexArrays(1, &name);
+                    break;
+                case GLObjectType::PROGRAM:
+                    glDeleteProgram(name);
+                    break;
+            }
+        }
+        name = 0;
+    }
+
+private:
+    GLuint name;
+    uint32_t generation;
+};
+
+typedef GLHandle<GLObjectType::BUFFER> GLBuffer;
+typedef GLHandle<GLObjectType::VERTEX_ARRAY> GLVertexArray;
+typedef GLHandle<GLObjectType::PROGRAM> GLProgram;
+
+#endif //BOYBOY_BBOYGL_H
@@ -27,3 +27,21 @@ bool AABB::overlaps(const AABB& other) const {
 //    LOGD("everything overlaps: a: %f %f, b: %f %f", min.z, max.z, other.min.z, other.max.z);
     return true;
 }
+
+bool AABB::contains(const AABB& other) const {
+    return min.x <= other.min.x && min.y <= other.min.y && min.z <= other.min.z &&
+           max.x >= other.max.x && max.y >= other.max.y && max.z >= other.max.z;
+}
+
+bool AABB::contains(const glm::vec2& point) const {
+    return min.x <= point.x && point.x <= max.x && min.y <= point.y && point.y <= max.y;
+}
+
+AABB AABB::combine(const AABB& other) const {
+    return AABB(glm::min(min, other.min), glm::max(max, other.max));
+}
+
+float AABB::perimeter() const {
+    // only x and y matter for the 2d game
+    return 2.0f * ((max.x - min.x) + (max.y - min.y));
+}
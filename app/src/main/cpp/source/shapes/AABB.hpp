@@ -14,6 +14,10 @@ public:
     ~AABB() = default;
 
     bool overlaps(const AABB&) const;
+    bool contains(const AABB&) const;
+    bool contains(const glm::vec2&) const;
+    AABB combine(const AABB&) const;
+    float perimeter() const;
 
     glm::vec4 min;
     glm::vec4 max;
@@ -0,0 +1,162 @@
+//
+// Created by Victor Zhang on 17/10/26.
+//
+
+#include <limits>
+#include <algorithm>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include "AABBBatch.hpp"
+
+// padding boxes are inverted and infinitely far away so they fail every test
+static const float PAD_MIN = std::numeric_limits<float>::infinity();
+static const float PAD_MAX = -std::numeric_limits<float>::infinity();
+
+static inline uint32_t tailMask(size_t start, size_t count) {
+    size_t remaining = count - start;
+    return remaining >= AABB_BATCH_WIDTH ? (1u << AABB_BATCH_WIDTH) - 1 : (1u << remaining) - 1;
+}
+
+void AABBBatch::clear() {
+    // only the used slots need to go back to padding
+    auto used = static_cast<std::ptrdiff_t>(std::min(count, minX.size()));
+    std::fill(minX.begin(), minX.begin() + used, PAD_MIN);
+    std::fill(minY.begin(), minY.begin() + used, PAD_MIN);
+    std::fill(maxX.begin(), maxX.begin() + used, PAD_MAX);
+    std::fill(maxY.begin(), maxY.begin() + used, PAD_MAX);
+
+    count = 0;
+}
+
+void AABBBatch::reserve(size_t size) {
+    // always keep a full batch of padding past the last element
+    size_t padded = size + AABB_BATCH_WIDTH;
+    if (padded <= minX.size()) {
+        return;
+    }
+
+    padded = std::max(padded, minX.size() * 2);
+    minX.resize(padded, PAD_MIN);
+    minY.resize(padded, PAD_MIN);
+    maxX.resize(padded, PAD_MAX);
+    maxY.resize(padded, PAD_MAX);
+}
+
+void AABBBatch::push(const AABB& box) {
+    reserve(count + 1);
+    set(count++, box);
+}
+
+void AABBBatch::set(size_t index, const AABB& box) {
+    minX[index] = box.min.x;
+    minY[index] = box.min.y;
+    maxX[index] = box.max.x;
+    maxY[index] = box.max.y;
+}
+
+void AABBBatch::swapRemove(size_t index) {
+    size_t last = count - 1;
+
+    minX[index] = minX[last];
+    minY[index] = minY[last];
+    maxX[index] = maxX[last];
+    maxY[index] = maxY[last];
+
+    minX[last] = PAD_MIN;
+    minY[last] = PAD_MIN;
+    maxX[last] = PAD_MAX;
+    maxY[last] = PAD_MAX;
+
+    count = last;
+}
+
+uint32_t AABBBatch::overlapMaskScalar(const AABB& box, size_t start) const {
+    if (start >= count) {
+        return 0;
+    }
+
+    uint32_t mask = 0;
+
+    for (size_t k = 0; k < AABB_BATCH_WIDTH; ++k) {
+        size_t i = start + k;
+        bool overlap = box.min.x <= maxX[i] && box.max.x >= minX[i] &&
+                       box.min.y <= maxY[i] && box.max.y >= minY[i];
+        mask |= static_cast<uint32_t>(overlap) << k;
+    }
+
+    return mask & tailMask(start, count);
+}
+
+#if defined(__SSE2__)
+
+uint32_t AABBBatch::overlapMask(const AABB& box, size_t start) const {
+    if (start >= count) {
+        return 0;
+    }
+
+    __m128 aMinX = _mm_set1_ps(box.min.x);
+    __m128 aMinY = _mm_set1_ps(box.min.y);
+    __m128 aMaxX = _mm_set1_ps(box.max.x);
+    __m128 aMaxY = _mm_set1_ps(box.max.y);
+
+    uint32_t mask = 0;
+    for (size_t k = 0; k < AABB_BATCH_WIDTH; k += 4) {
+        size_t i = start + k;
+        __m128 x = _mm_and_ps(_mm_cmple_ps(aMinX, _mm_loadu_ps(&maxX[i])),
+                              _mm_cmpge_ps(aMaxX, _mm_loadu_ps(&minX[i])));
+        __m128 y = _mm_and_ps(_mm_cmple_ps(aMinY, _mm_loadu_ps(&maxY[i])),
+                              _mm_cmpge_ps(aMaxY, _mm_loadu_ps(&minY[i])));
+        mask |= static_cast<uint32_t>(_mm_movemask_ps(_mm_and_ps(x, y))) << k;
+    }
+
+    return mask & tailMask(start, count);
+}
+
+#elif defined(__ARM_NEON)
+
+static inline uint32_t neonMovemask(uint32x4_t lanes) {
+    static const uint32_t bits[4] = {1, 2, 4, 8};
+    uint32x4_t masked = vandq_u32(lanes, vld1q_u32(bits));
+#if defined(__aarch64__)
+    return vaddvq_u32(masked);
+#else
+    uint32x2_t sum = vadd_u32(vget_low_u32(masked), vget_high_u32(masked));
+    return vget_lane_u32(vpadd_u32(sum, sum), 0);
+#endif
+}
+
+uint32_t AABBBatch::overlapMask(const AABB& box, size_t start) const {
+    if (start >= count) {
+        return 0;
+    }
+
+    float32x4_t aMinX = vdupq_n_f32(box.min.x);
+    float32x4_t aMinY = vdupq_n_f32(box.min.y);
+    float32x4_t aMaxX = vdupq_n_f32(box.max.x);
+    float32x4_t aMaxY = vdupq_n_f32(box.max.y);
+
+    uint32_t mask = 0;
+    for (size_t k = 0; k < AABB_BATCH_WIDTH; k += 4) {
+        size_t i = start + k;
+        uint32x4_t x = vandq_u32(vcleq_f32(aMinX, vld1q_f32(&maxX[i])),
+                                 vcgeq_f32(aMaxX, vld1q_f32(&minX[i])));
+        uint32x4_t y = vandq_u32(vcleq_f32(aMinY, vld1q_f32(&maxY[i])),
+                                 vcgeq_f32(aMaxY, vld1q_f32(&minY[i])));
+        mask |= neonMovemask(vandq_u32(x, y)) << k;
+    }
+
+    return mask & tailMask(start, count);
+}
+
+#else
+
+uint32_t AABBBatch::overlapMask(const AABB& box, size_t start) const {
+    return overlapMaskScalar(box, start);
+}
+
+#endif
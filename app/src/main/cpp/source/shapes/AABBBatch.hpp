@@ -0,0 +1,44 @@
+//
+// Created by Victor Zhang on 17/10/26.
+//
+
+#ifndef BOYBOY_AABBBATCH_HPP
+#define BOYBOY_AABBBATCH_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "AABB.hpp"
+
+// number of boxes tested per overlapMask call
+#define AABB_BATCH_WIDTH 8
+
+// structure of arrays store for 2d bounds (z is ignored)
+// arrays are padded with boxes which never overlap so a full batch can always be loaded
+class AABBBatch {
+public:
+    AABBBatch() = default;
+    ~AABBBatch() = default;
+
+    void clear();
+    void push(const AABB&);
+    void set(size_t, const AABB&);
+    void swapRemove(size_t);
+    size_t size() const { return count; }
+
+    // bit k is set when the box overlaps element start + k (bits past size are clear)
+    uint32_t overlapMask(const AABB&, size_t) const;
+    uint32_t overlapMaskScalar(const AABB&, size_t) const;
+
+private:
+    void reserve(size_t);
+
+    std::vector<float> minX;
+    std::vector<float> minY;
+    std::vector<float> maxX;
+    std::vector<float> maxY;
+    size_t count = 0;
+};
+
+#endif //BOYBOY_AABBBATCH_HPP
@@ -0,0 +1,55 @@
+//
+// Created by Victor Zhang on 17/10/26.
+//
+
+#include <cstddef>
+
+#include "core/bboycore.hpp"
+
+#include "AABBOverlay.hpp"
+
+#define AABB_OUTLINE_VERTICES 4
+
+AABBOverlay::AABBOverlay() : instanceCapacity(0), instanceCount(0)
+{
+    // setup opengl
+    // generate buffers
+    instanceBuffer = GLBuffer::generate();
+    overlayVAO = GLVertexArray::generate();
+
+    // bind the box bounds, both advance once per box
+    glBindVertexArray(overlayVAO.get());
+    glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer.get());
+    glVertexAttribPointer(BOUNDS_MIN_ATTRIB, 2, GL_FLOAT, GL_FALSE, sizeof(AABBInstance), (void*)offsetof(AABBInstance, min));
+    glEnableVertexAttribArray(BOUNDS_MIN_ATTRIB);
+    glVertexAttribDivisor(BOUNDS_MIN_ATTRIB, 1);
+    glVertexAttribPointer(BOUNDS_MAX_ATTRIB, 2, GL_FLOAT, GL_FALSE, sizeof(AABBInstance), (void*)offsetof(AABBInstance, max));
+    glEnableVertexAttribArray(BOUNDS_MAX_ATTRIB);
+    glVertexAttribDivisor(BOUNDS_MAX_ATTRIB, 1);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void AABBOverlay::SetBounds(std::vector<AABBInstance> const& bounds)
+{
+    instanceCount = static_cast<GLsizei>(bounds.size());
+    if (bounds.empty()) {
+        return;
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer.get());
+    streamBufferData(GL_ARRAY_BUFFER, instanceCapacity, sizeof(AABBInstance) * bounds.size(), bounds.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void AABBOverlay::Draw() const
+{
+    if (instanceCount == 0) {
+        return;
+    }
+
+    glBindVertexArray(overlayVAO.get());
+    glDrawArraysInstanced(GL_LINE_LOOP, 0, AABB_OUTLINE_VERTICES, instanceCount);
+    glBindVertexArray(0);
+}
@@ -0,0 +1,38 @@
+//
+// Created by Victor Zhang on 17/10/26.
+//
+
+#ifndef BOYBOY_AABBOVERLAY_HPP
+#define BOYBOY_AABBOVERLAY_HPP
+
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "core/bboygl.hpp"
+
+// per instance attributes read by the overlay program (BOUNDS_MIN_ATTRIB and BOUNDS_MAX_ATTRIB)
+struct AABBInstance {
+    glm::vec2 min;
+    glm::vec2 max;
+};
+
+// debug outlines of any number of boxes in one instanced line loop
+// there is no vertex data, the program expands the four corners from gl_VertexID
+class AABBOverlay {
+public:
+    AABBOverlay();
+    AABBOverlay(AABBOverlay&&) = default;
+    AABBOverlay& operator=(AABBOverlay&&) = default;
+    ~AABBOverlay() = default;
+    // replaces the boxes drawn by Draw
+    void SetBounds(std::vector<AABBInstance> const&);
+    void Draw() const;
+private:
+    GLBuffer instanceBuffer;
+    GLVertexArray overlayVAO;
+    GLsizeiptr instanceCapacity;
+    GLsizei instanceCount;
+};
+
+
+#endif //BOYBOY_AABBOVERLAY_HPP
@@ -0,0 +1,418 @@
+//
+// Created by Victor Zhang on 17/10/26.
+//
+
+#include <algorithm>
+
+#include "AABBTree.hpp"
+
+AABBTree::AABBTree(float margin) : margin(margin) {}
+
+int32_t AABBTree::createProxy(const AABB& aabb, uint32_t userData) {
+    int32_t proxyId = allocateNode();
+
+    Node& node = nodes[proxyId];
+    node.aabb = fatten(aabb);
+    node.userData = userData;
+    node.height = 0;
+
+    insertLeaf(proxyId);
+
+    return proxyId;
+}
+
+void AABBTree::destroyProxy(int32_t proxyId) {
+    removeLeaf(proxyId);
+    freeNode(proxyId);
+}
+
+bool AABBTree::moveProxy(int32_t proxyId, const AABB& aabb) {
+    // still inside the fat bounds, nothing to do
+    if (nodes[proxyId].aabb.contains(aabb)) {
+        return false;
+    }
+
+    removeLeaf(proxyId);
+    nodes[proxyId].aabb = fatten(aabb);
+    insertLeaf(proxyId);
+
+    return true;
+}
+
+void AABBTree::clear() {
+    nodes.clear();
+    proxies.clear();
+    moveBuffer.clear();
+    moved.clear();
+    fatPairs.clear();
+    fatPairKeys.clear();
+    root = AABB_TREE_NULL_NODE;
+    freeList = AABB_TREE_NULL_NODE;
+}
+
+static inline uint64_t pairKey(uint32_t a, uint32_t b) {
+    return (static_cast<uint64_t>(a) << 32) | b;
+}
+
+void AABBTree::findPairs(std::vector<AABB> const& bounds, std::vector<uint8_t> const& enabled,
+                         std::vector<std::pair<uint32_t, uint32_t>>& pairs) {
+    pairs.clear();
+
+    bool destroyed = syncProxies(bounds, enabled);
+
+    // drop pairs which lost a proxy or whose fat bounds no longer overlap (only moved proxies change theirs)
+    if (destroyed || !moveBuffer.empty()) {
+        auto kept = std::remove_if(fatPairs.begin(), fatPairs.end(), [&](std::pair<uint32_t, uint32_t> const& pair) {
+            int32_t proxyA = proxies[pair.first];
+            int32_t proxyB = proxies[pair.second];
+            bool stale = proxyA == AABB_TREE_NULL_NODE || proxyB == AABB_TREE_NULL_NODE ||
+                         ((moved[pair.first] || moved[pair.second]) && !nodes[proxyA].aabb.overlaps(nodes[proxyB].aabb));
+            if (stale) {
+                fatPairKeys.erase(pairKey(pair.first, pair.second));
+            }
+            return stale;
+        });
+        fatPairs.erase(kept, fatPairs.end());
+    }
+
+    // only moved proxies can have gained a neighbour
+    for (uint32_t slot : moveBuffer) {
+        query(nodes[proxies[slot]].aabb, [&](int32_t proxyId) {
+            uint32_t other = nodes[proxyId].userData;
+
+            // when both moved the pair is picked up by the query from the higher slot
+            if (other == slot || (moved[other] && other > slot)) {
+                return true;
+            }
+            addPair(std::min(slot, other), std::max(slot, other));
+            return true;
+        });
+    }
+
+    for (uint32_t slot : moveBuffer) {
+        moved[slot] = 0;
+    }
+    moveBuffer.clear();
+
+    // the fat pairs are a superset, report the ones whose real bounds overlap
+    for (auto const& pair : fatPairs) {
+        if (bounds[pair.first].overlaps(bounds[pair.second])) {
+            pairs.push_back(pair);
+        }
+    }
+}
+
+bool AABBTree::syncProxies(std::vector<AABB> const& bounds, std::vector<uint8_t> const& enabled) {
+    auto count = static_cast<uint32_t>(enabled.size());
+    bool destroyed = false;
+
+    // slots past the end of the world are gone
+    for (uint32_t slot = count; slot < proxies.size(); ++slot) {
+        if (proxies[slot] != AABB_TREE_NULL_NODE) {
+            destroyProxy(proxies[slot]);
+            destroyed = true;
+        }
+    }
+    if (destroyed) {
+        // their pairs are dropped before the arrays shrink
+        auto kept = std::remove_if(fatPairs.begin(), fatPairs.end(), [&](std::pair<uint32_t, uint32_t> const& pair) {
+            bool gone = pair.second >= count;
+            if (gone) {
+                fatPairKeys.erase(pairKey(pair.first, pair.second));
+            }
+            return gone;
+        });
+        fatPairs.erase(kept, fatPairs.end());
+    }
+    proxies.resize(count, AABB_TREE_NULL_NODE);
+    moved.resize(count, 0);
+
+    for (uint32_t slot = 0; slot < count; ++slot) {
+        int32_t& proxy = proxies[slot];
+
+        if (!enabled[slot]) {
+            if (proxy != AABB_TREE_NULL_NODE) {
+                destroyProxy(proxy);
+                proxy = AABB_TREE_NULL_NODE;
+                destroyed = true;
+            }
+            continue;
+        }
+
+        // only proxies which left their fat bounds are reinserted
+        bool reinserted;
+        if (proxy == AABB_TREE_NULL_NODE) {
+            proxy = createProxy(bounds[slot], slot);
+            reinserted = true;
+        } else {
+            reinserted = moveProxy(proxy, bounds[slot]);
+        }
+
+        if (reinserted) {
+            moveBuffer.push_back(slot);
+            moved[slot] = 1;
+        }
+    }
+
+    return destroyed;
+}
+
+void AABBTree::addPair(uint32_t a, uint32_t b) {
+    if (fatPairKeys.insert(pairKey(a, b)).second) {
+        fatPairs.emplace_back(a, b);
+    }
+}
+
+int32_t AABBTree::allocateNode() {
+    int32_t index;
+
+    if (freeList == AABB_TREE_NULL_NODE) {
+        index = static_cast<int32_t>(nodes.size());
+        nodes.emplace_back();
+    } else {
+        index = freeList;
+        freeList = nodes[index].parent;
+    }
+
+    Node& node = nodes[index];
+    node.parent = AABB_TREE_NULL_NODE;
+    node.child1 = AABB_TREE_NULL_NODE;
+    node.child2 = AABB_TREE_NULL_NODE;
+    node.height = 0;
+    node.userData = 0;
+
+    return index;
+}
+
+void AABBTree::freeNode(int32_t index) {
+    nodes[index].parent = freeList;
+    nodes[index].height = -1;
+    freeList = index;
+}
+
+void AABBTree::insertLeaf(int32_t leaf) {
+    if (root == AABB_TREE_NULL_NODE) {
+        root = leaf;
+        nodes[root].parent = AABB_TREE_NULL_NODE;
+        return;
+    }
+
+    // find the best sibling by walking down the cheapest (perimeter) branch
+    AABB leafAABB = nodes[leaf].aabb;
+    int32_t index = root;
+    while (!nodes[index].isLeaf()) {
+        int32_t child1 = nodes[index].child1;
+        int32_t child2 = nodes[index].child2;
+
+        float area = nodes[index].aabb.perimeter();
+        float combinedArea = nodes[index].aabb.combine(leafAABB).perimeter();
+
+        // cost of creating a new parent for this node and the new leaf
+        float cost = 2.0f * combinedArea;
+
+        // minimum cost of pushing the leaf further down the tree
+        float inheritanceCost = 2.0f * (combinedArea - area);
+
+        float cost1 = leafAABB.combine(nodes[child1].aabb).perimeter() + inheritanceCost;
+        if (!nodes[child1].isLeaf()) {
+            cost1 -= nodes[child1].aabb.perimeter();
+        }
+
+        float cost2 = leafAABB.combine(nodes[child2].aabb).perimeter() + inheritanceCost;
+        if (!nodes[child2].isLeaf()) {
+            cost2 -= nodes[child2].aabb.perimeter();
+        }
+
+        if (cost < cost1 && cost < cost2) {
+            break;
+        }
+
+        index = cost1 < cost2 ? child1 : child2;
+    }
+
+    int32_t sibling = index;
+
+    // create a new parent (allocation may grow nodes so grab no references before this)
+    int32_t oldParent = nodes[sibling].parent;
+    int32_t newParent = allocateNode();
+    nodes[newParent].parent = oldParent;
+    nodes[newParent].aabb = leafAABB.combine(nodes[sibling].aabb);
+    nodes[newParent].height = nodes[sibling].height + 1;
+
+    if (oldParent != AABB_TREE_NULL_NODE) {
+        if (nodes[oldParent].child1 == sibling) {
+            nodes[oldParent].child1 = newParent;
+        } else {
+            nodes[oldParent].child2 = newParent;
+        }
+    } else {
+        root = newParent;
+    }
+
+    nodes[newParent].child1 = sibling;
+    nodes[newParent].child2 = leaf;
+    nodes[sibling].parent = newParent;
+    nodes[leaf].parent = newParent;
+
+    refit(nodes[leaf].parent);
+}
+
+void AABBTree::removeLeaf(int32_t leaf) {
+    if (leaf == root) {
+        root = AABB_TREE_NULL_NODE;
+        return;
+    }
+
+    int32_t parent = nodes[leaf].parent;
+    int32_t grandParent = nodes[parent].parent;
+    int32_t sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+    if (grandParent == AABB_TREE_NULL_NODE) {
+        root = sibling;
+        nodes[sibling].parent = AABB_TREE_NULL_NODE;
+        freeNode(parent);
+        return;
+    }
+
+    // replace the parent with the sibling
+    if (nodes[grandParent].child1 == parent) {
+        nodes[grandParent].child1 = sibling;
+    } else {
+        nodes[grandParent].child2 = sibling;
+    }
+    nodes[sibling].parent = grandParent;
+    freeNode(parent);
+
+    refit(grandParent);
+}
+
+void AABBTree::refit(int32_t index) {
+    // walk back up fixing heights and bounds, rotating where unbalanced
+    while (index != AABB_TREE_NULL_NODE) {
+        index = balance(index);
+
+        Node& node = nodes[index];
+        const Node& child1 = nodes[node.child1];
+        const Node& child2 = nodes[node.child2];
+
+        node.height = 1 + std::max(child1.height, child2.height);
+        node.aabb = child1.aabb.combine(child2.aabb);
+
+        index = node.parent;
+    }
+}
+
+int32_t AABBTree::balance(int32_t iA) {
+    Node& A = nodes[iA];
+    if (A.isLeaf() || A.height < 2) {
+        return iA;
+    }
+
+    int32_t iB = A.child1;
+    int32_t iC = A.child2;
+    Node& B = nodes[iB];
+    Node& C = nodes[iC];
+
+    int32_t heightDiff = C.height - B.height;
+
+    // rotate C up
+    if (heightDiff > 1) {
+        int32_t iF = C.child1;
+        int32_t iG = C.child2;
+        Node& F = nodes[iF];
+        Node& G = nodes[iG];
+
+        // swap A and C
+        C.child1 = iA;
+        C.parent = A.parent;
+        A.parent = iC;
+
+        // A's old parent should point to C
+        if (C.parent != AABB_TREE_NULL_NODE) {
+            if (nodes[C.parent].child1 == iA) {
+                nodes[C.parent].child1 = iC;
+            } else {
+                nodes[C.parent].child2 = iC;
+            }
+        } else {
+            root = iC;
+        }
+
+        // keep the taller grandchild under C
+        if (F.height > G.height) {
+            C.child2 = iF;
+            A.child2 = iG;
+            G.parent = iA;
+            A.aabb = B.aabb.combine(G.aabb);
+            C.aabb = A.aabb.combine(F.aabb);
+
+            A.height = 1 + std::max(B.height, G.height);
+            C.height = 1 + std::max(A.height, F.height);
+        } else {
+            C.child2 = iG;
+            A.child2 = iF;
+            F.parent = iA;
+            A.aabb = B.aabb.combine(F.aabb);
+            C.aabb = A.aabb.combine(G.aabb);
+
+            A.height = 1 + std::max(B.height, F.height);
+            C.height = 1 + std::max(A.height, G.height);
+        }
+
+        return iC;
+    }
+
+    // rotate B up
+    if (heightDiff < -1) {
+        int32_t iD = B.child1;
+        int32_t iE = B.child2;
+        Node& D = nodes[iD];
+        Node& E = nodes[iE];
+
+        // swap A and B
+        B.child1 = iA;
+        B.parent = A.parent;
+        A.parent = iB;
+
+        // A's old parent should point to B
+        if (B.parent != AABB_TREE_NULL_NODE) {
+            if (nodes[B.parent].child1 == iA) {
+                nodes[B.parent].child1 = iB;
+            } else {
+                nodes[B.parent].child2 = iB;
+            }
+        } else {
+            root = iB;
+        }
+
+        // keep the taller grandchild under B
+        if (D.height > E.height) {
+            B.child2 = iD;
+            A.child1 = iE;
+            E.parent = iA;
+            A.aabb = C.aabb.combine(E.aabb);
+            B.aabb = A.aabb.combine(D.aabb);
+
+            A.height = 1 + std::max(C.height, E.height);
+            B.height = 1 + std::max(A.height, D.height);
+        } else {
+            B.child2 = iE;
+            A.child1 = iD;
+            D.parent = iA;
+            A.aabb = C.aabb.combine(D.aabb);
+            B.aabb = A.aabb.combine(E.aabb);
+
+            A.height = 1 + std::max(C.height, D.height);
+            B.height = 1 + std::max(A.height, E.height);
+        }
+
+        return iB;
+    }
+
+    return iA;
+}
+
+AABB AABBTree::fatten(const AABB& aabb) const {
+    glm::vec4 extent(margin, margin, 0.0f, 0.0f);
+    return AABB(aabb.min - extent, aabb.max + extent);
+}
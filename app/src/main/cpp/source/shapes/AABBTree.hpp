@@ -0,0 +1,148 @@
+//
+// Created by Victor Zhang on 17/10/26.
+//
+
+#ifndef BOYBOY_AABBTREE_HPP
+#define BOYBOY_AABBTREE_HPP
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <unordered_set>
+
+#include <glm/glm.hpp>
+
+#include "AABB.hpp"
+
+#define AABB_TREE_NULL_NODE (-1)
+#define AABB_TREE_DEFAULT_MARGIN 0.5f
+
+// dynamic bounding volume tree
+// leaves store fattened bounds so small movements do not touch the tree,
+// a proxy is only reinserted once its real bounds leave its fat bounds
+class AABBTree {
+public:
+    explicit AABBTree(float margin);
+    AABBTree() : AABBTree(AABB_TREE_DEFAULT_MARGIN) {}
+    ~AABBTree() = default;
+
+    int32_t createProxy(const AABB&, uint32_t);
+    void destroyProxy(int32_t);
+    bool moveProxy(int32_t, const AABB&);
+    void clear();
+
+    uint32_t getUserData(int32_t proxyId) const { return nodes[proxyId].userData; }
+    const AABB& getFatAABB(int32_t proxyId) const { return nodes[proxyId].aabb; }
+    int32_t getHeight() const { return root == AABB_TREE_NULL_NODE ? 0 : nodes[root].height; }
+
+    // callback(proxyId) returns false to stop the query early (queries are not reentrant)
+    template <typename T> void query(const AABB&, T) const;
+    template <typename T> void queryPoint(const glm::vec2&, T) const;
+
+    // keeps one proxy per enabled world slot (proxy user data is the slot, bounds and enabled flags are
+    // indexed by slot) and reports each overlapping pair of real bounds once, as slots
+    // only proxies which were created or reinserted query the tree, every other pair is carried over
+    // between calls so bodies resting inside their fat bounds cost no tree work
+    void findPairs(std::vector<AABB> const&, std::vector<uint8_t> const&, std::vector<std::pair<uint32_t, uint32_t>>&);
+
+private:
+    struct Node {
+        AABB aabb;
+        // parent when in use, next free node otherwise
+        int32_t parent;
+        int32_t child1;
+        int32_t child2;
+        // leaf = 0, free = -1
+        int32_t height;
+        uint32_t userData;
+
+        bool isLeaf() const { return child1 == AABB_TREE_NULL_NODE; }
+    };
+
+    int32_t allocateNode();
+    void freeNode(int32_t);
+    void insertLeaf(int32_t);
+    void removeLeaf(int32_t);
+    int32_t balance(int32_t);
+    void refit(int32_t);
+    AABB fatten(const AABB&) const;
+    // creates, moves and destroys proxies to match the enabled slots, filling moveBuffer
+    // returns true if any proxy was destroyed
+    bool syncProxies(std::vector<AABB> const&, std::vector<uint8_t> const&);
+    void addPair(uint32_t, uint32_t);
+
+    std::vector<Node> nodes;
+    int32_t root = AABB_TREE_NULL_NODE;
+    int32_t freeList = AABB_TREE_NULL_NODE;
+    float margin;
+
+    // proxy per slot (AABB_TREE_NULL_NODE while disabled)
+    std::vector<int32_t> proxies;
+    // slots whose proxy was created or reinserted this call, and a flag per slot for the same
+    std::vector<uint32_t> moveBuffer;
+    std::vector<uint8_t> moved;
+    // pairs of slots whose fat bounds overlap (kept until they separate or a proxy goes away)
+    std::vector<std::pair<uint32_t, uint32_t>> fatPairs;
+    std::unordered_set<uint64_t> fatPairKeys;
+    mutable std::vector<int32_t> stack;
+};
+
+template <typename T>
+void AABBTree::query(const AABB& box, T callback) const {
+    stack.clear();
+    stack.push_back(root);
+
+    while (!stack.empty()) {
+        int32_t index = stack.back();
+        stack.pop_back();
+
+        if (index == AABB_TREE_NULL_NODE) {
+            continue;
+        }
+
+        const Node& node = nodes[index];
+        if (!node.aabb.overlaps(box)) {
+            continue;
+        }
+
+        if (node.isLeaf()) {
+            if (!callback(index)) {
+                return;
+            }
+        } else {
+            stack.push_back(node.child1);
+            stack.push_back(node.child2);
+        }
+    }
+}
+
+template <typename T>
+void AABBTree::queryPoint(const glm::vec2& point, T callback) const {
+    stack.clear();
+    stack.push_back(root);
+
+    while (!stack.empty()) {
+        int32_t index = stack.back();
+        stack.pop_back();
+
+        if (index == AABB_TREE_NULL_NODE) {
+            continue;
+        }
+
+        const Node& node = nodes[index];
+        if (!node.aabb.contains(point)) {
+            continue;
+        }
+
+        if (node.isLeaf()) {
+            if (!callback(index)) {
+                return;
+            }
+        } else {
+            stack.push_back(node.child1);
+            stack.push_back(node.child2);
+        }
+    }
+}
+
+#endif //BOYBOY_AABBTREE_HPP
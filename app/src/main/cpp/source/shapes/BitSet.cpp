@@ -0,0 +1,23 @@
+//
+// Created by Victor Zhang on 17/10/26.
+//
+
+#include <algorithm>
+
+#include "BitSet.hpp"
+
+void BitSet::resize(size_t size) {
+    size_t wordCount = (size + 63) >> 6;
+
+    // drop any bits past the new size so forEach never reports them
+    if (size < count && wordCount > 0 && (size & 63) != 0) {
+        words[wordCount - 1] &= (uint64_t(1) << (size & 63)) - 1;
+    }
+
+    words.resize(wordCount, 0);
+    count = size;
+}
+
+void BitSet::reset() {
+    std::fill(words.begin(), words.end(), 0);
+}
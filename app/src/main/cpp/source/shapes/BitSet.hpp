@@ -0,0 +1,46 @@
+//
+// Created by Victor Zhang on 17/10/26.
+//
+
+#ifndef BOYBOY_BITSET_HPP
+#define BOYBOY_BITSET_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// growable flag array packed into 64 bit words
+// resize only allocates when growing so per tick reset/set/test never touch the heap
+class BitSet {
+public:
+    BitSet() = default;
+    ~BitSet() = default;
+
+    void resize(size_t);
+    void reset();
+    size_t size() const { return count; }
+
+    void set(size_t index) { words[index >> 6] |= uint64_t(1) << (index & 63); }
+    void clear(size_t index) { words[index >> 6] &= ~(uint64_t(1) << (index & 63)); }
+    bool test(size_t index) const { return (words[index >> 6] >> (index & 63)) & 1; }
+
+    // callback(index) for every set bit in ascending order
+    template <typename T> void forEach(T) const;
+
+private:
+    std::vector<uint64_t> words;
+    size_t count = 0;
+};
+
+template <typename T>
+void BitSet::forEach(T callback) const {
+    for (size_t w = 0; w < words.size(); ++w) {
+        uint64_t word = words[w];
+        while (word != 0) {
+            callback((w << 6) + __builtin_ctzll(word));
+            word &= word - 1;
+        }
+    }
+}
+
+#endif //BOYBOY_BITSET_HPP
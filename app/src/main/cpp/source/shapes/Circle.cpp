@@ -38,12 +38,12 @@ Circle::Circle(Vector3 origin, float radius, int partitions)
 
     // setup opengl
     // generate buffers
-    glGenBuffers(1, &circleBuffer);
-    glGenVertexArrays(1, &circleVAO);
+    circleBuffer = GLBuffer::generate();
+    circleVAO = GLVertexArray::generate();
 
     // bind circle
-    glBindVertexArray(circleVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, circleBuffer);
+    glBindVertexArray(circleVAO.get());
+    glBindBuffer(GL_ARRAY_BUFFER, circleBuffer.get());
     glBufferData(GL_ARRAY_BUFFER, sizeof(*vertices.begin()) * vertices.size(), vertices.data(), GL_STATIC_DRAW);
     glVertexAttribPointer(POS_ATTRIB, 3, GL_FLOAT, GL_FALSE, 0, 0);
     glEnableVertexAttribArray(POS_ATTRIB);
@@ -55,7 +55,7 @@ Circle::Circle(Vector3 origin, float radius, int partitions)
 void Circle::Draw()
 {
     // draw circle loop at (0, 0)
-    glBindVertexArray(circleVAO);
+    glBindVertexArray(circleVAO.get());
     glDrawArrays(GL_LINE_LOOP, 0, numPartitions);
     glBindVertexArray(0);
 }
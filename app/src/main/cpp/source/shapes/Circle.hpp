@@ -6,7 +6,7 @@
 #define BOYBOY_CIRCLE_H
 
 #include <vector>
-#include <GLES3/gl32.h>
+#include "core/bboygl.hpp"
 #include "Vector3.hpp"
 
 #define CIRCLE_DEFAULT_PARTITIONS 100
@@ -16,14 +16,17 @@ public:
     Circle(Vector3, float, int);
     Circle(Vector3 origin, float radius) : Circle(origin, radius, CIRCLE_DEFAULT_PARTITIONS) {}
     Circle() : Circle(Vector3(), 1.0f) {}
-    ~Circle() {}
+    Circle(Circle&&) = default;
+    Circle& operator=(Circle&&) = default;
+    ~Circle() = default;
     void Draw();
 private:
     std::vector<Vector3> vertices;
     Vector3 origin;
     float radius;
     int numPartitions;
-    GLuint circleBuffer, circleVAO;
+    GLBuffer circleBuffer;
+    GLVertexArray circleVAO;
 };
 
 
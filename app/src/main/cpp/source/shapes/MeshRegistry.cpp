@@ -0,0 +1,11 @@
+//
+// Created by Victor Zhang on 17/10/26.
+//
+
+#include "MeshRegistry.hpp"
+
+void MeshRegistry::create() {
+    quad.reset(new Quad());
+    circle.reset(new Circle());
+    aabbOverlay.reset(new AABBOverlay());
+}
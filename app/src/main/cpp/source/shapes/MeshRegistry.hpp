@@ -0,0 +1,38 @@
+//
+// Created by Victor Zhang on 17/10/26.
+//
+
+#ifndef BOYBOY_MESHREGISTRY_HPP
+#define BOYBOY_MESHREGISTRY_HPP
+
+#include <memory>
+
+#include "AABBOverlay.hpp"
+#include "Circle.hpp"
+#include "Quad.hpp"
+
+// every mesh the renderer draws, uploaded once per GL context and shared by all entities
+// entities only carry a MeshType (see World) so GL objects do not grow with the entity count
+class MeshRegistry {
+public:
+    MeshRegistry() = default;
+    ~MeshRegistry() = default;
+
+    // uploads every mesh, needs a current GL context
+    // calling it again (new context) replaces the meshes of the old one
+    void create();
+    bool isCreated() const { return quad != nullptr; }
+
+    // only valid once created
+    Quad& getQuad() const { return *quad; }
+    Circle& getCircle() const { return *circle; }
+    AABBOverlay& getAABBOverlay() const { return *aabbOverlay; }
+
+private:
+    std::unique_ptr<Quad> quad;
+    std::unique_ptr<Circle> circle;
+    std::unique_ptr<AABBOverlay> aabbOverlay;
+};
+
+
+#endif //BOYBOY_MESHREGISTRY_HPP
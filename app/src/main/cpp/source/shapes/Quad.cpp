@@ -0,0 +1,95 @@
+//
+// Created by Victor Zhang on 17/10/26.
+//
+
+#include <cstddef>
+
+#include "core/bboycore.hpp"
+
+#include "Quad.hpp"
+
+#define QUAD_FILL_INDICES 6
+#define QUAD_OUTLINE_INDICES 4
+
+Quad::Quad() : instanceCapacity(0), instanceCount(0)
+{
+    // generate vertices
+    vertices.emplace_back(-QUAD_HALF_WIDTH, QUAD_HALF_HEIGHT, 0.0f);
+    vertices.emplace_back(QUAD_HALF_WIDTH, QUAD_HALF_HEIGHT, 0.0f);
+    vertices.emplace_back(QUAD_HALF_WIDTH, -QUAD_HALF_HEIGHT, 0.0f);
+    vertices.emplace_back(-QUAD_HALF_WIDTH, -QUAD_HALF_HEIGHT, 0.0f);
+
+    // generate indices (two triangles then the outline loop)
+    indices = {0, 2, 1,
+               0, 3, 2,
+               0, 1, 2, 3};
+
+    // setup opengl
+    // generate buffers
+    quadVertexBuffer = GLBuffer::generate();
+    quadIndexBuffer = GLBuffer::generate();
+    quadInstanceBuffer = GLBuffer::generate();
+    quadVAO = GLVertexArray::generate();
+
+    // bind quad
+    glBindVertexArray(quadVAO.get());
+    glBindBuffer(GL_ARRAY_BUFFER, quadVertexBuffer.get());
+    glBufferData(GL_ARRAY_BUFFER, sizeof(*vertices.begin()) * vertices.size(), vertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, quadIndexBuffer.get());
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(*indices.begin()) * indices.size(), indices.data(), GL_STATIC_DRAW);
+    glVertexAttribPointer(POS_ATTRIB, 3, GL_FLOAT, GL_FALSE, 0, 0);
+    glEnableVertexAttribArray(POS_ATTRIB);
+
+    // instance attributes advance once per quad (a mat4 takes four vec4 slots)
+    glBindBuffer(GL_ARRAY_BUFFER, quadInstanceBuffer.get());
+    for (GLuint i = 0; i < 4; ++i) {
+        glVertexAttribPointer(MODEL_ATTRIB + i, 4, GL_FLOAT, GL_FALSE, sizeof(QuadInstance),
+                              (void*)(offsetof(QuadInstance, model) + i * sizeof(glm::vec4)));
+        glEnableVertexAttribArray(MODEL_ATTRIB + i);
+        glVertexAttribDivisor(MODEL_ATTRIB + i, 1);
+    }
+    glVertexAttribPointer(COLOR_ATTRIB, 4, GL_FLOAT, GL_FALSE, sizeof(QuadInstance), (void*)offsetof(QuadInstance, color));
+    glEnableVertexAttribArray(COLOR_ATTRIB);
+    glVertexAttribDivisor(COLOR_ATTRIB, 1);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+void Quad::Draw() const
+{
+    glBindVertexArray(quadVAO.get());
+    glDrawElements(GL_TRIANGLES, QUAD_FILL_INDICES, GL_UNSIGNED_INT, 0);
+    glBindVertexArray(0);
+}
+
+void Quad::DrawOutline() const
+{
+    glBindVertexArray(quadVAO.get());
+    glDrawElements(GL_LINE_LOOP, QUAD_OUTLINE_INDICES, GL_UNSIGNED_INT, (void*)(QUAD_FILL_INDICES * sizeof(GLuint)));
+    glBindVertexArray(0);
+}
+
+void Quad::SetInstances(std::vector<QuadInstance> const& instances)
+{
+    instanceCount = static_cast<GLsizei>(instances.size());
+    if (instances.empty()) {
+        return;
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, quadInstanceBuffer.get());
+    streamBufferData(GL_ARRAY_BUFFER, instanceCapacity, sizeof(QuadInstance) * instances.size(), instances.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void Quad::DrawInstanced() const
+{
+    if (instanceCount == 0) {
+        return;
+    }
+
+    glBindVertexArray(quadVAO.get());
+    glDrawElementsInstanced(GL_TRIANGLES, QUAD_FILL_INDICES, GL_UNSIGNED_INT, 0, instanceCount);
+    glBindVertexArray(0);
+}
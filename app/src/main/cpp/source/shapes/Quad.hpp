@@ -0,0 +1,45 @@
+//
+// Created by Victor Zhang on 17/10/26.
+//
+
+#ifndef BOYBOY_QUAD_H
+#define BOYBOY_QUAD_H
+
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "core/bboygl.hpp"
+
+// local half size of the quad mesh (a 4x2 rectangle centred on the origin)
+#define QUAD_HALF_WIDTH 2.0f
+#define QUAD_HALF_HEIGHT 1.0f
+
+// per instance attributes read by DrawInstanced (MODEL_ATTRIB and COLOR_ATTRIB)
+struct QuadInstance {
+    glm::mat4 model;
+    glm::vec4 color;
+};
+
+class Quad {
+public:
+    Quad();
+    Quad(Quad&&) = default;
+    Quad& operator=(Quad&&) = default;
+    ~Quad() = default;
+    void Draw() const;
+    void DrawOutline() const;
+    // replaces the instances drawn by DrawInstanced
+    void SetInstances(std::vector<QuadInstance> const&);
+    // every instance in one draw call (needs a program reading the instance attributes)
+    void DrawInstanced() const;
+private:
+    std::vector<glm::vec3> vertices;
+    std::vector<GLuint> indices;
+    GLBuffer quadVertexBuffer, quadIndexBuffer, quadInstanceBuffer;
+    GLVertexArray quadVAO;
+    GLsizeiptr instanceCapacity;
+    GLsizei instanceCount;
+};
+
+
+#endif //BOYBOY_QUAD_H
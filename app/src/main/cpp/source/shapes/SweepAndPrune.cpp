@@ -0,0 +1,126 @@
+//
+// Created by Victor Zhang on 17/10/26.
+//
+
+#include <algorithm>
+
+#include "SweepAndPrune.hpp"
+
+static inline bool endpointLess(float aValue, uint32_t aData, float bValue, uint32_t bData) {
+    // min endpoints sort before max endpoints on ties so touching boxes still overlap
+    return aValue < bValue || (aValue == bValue && (aData & 1u) < (bData & 1u));
+}
+
+void SweepAndPrune::findPairs(std::vector<AABB> const& bounds, std::vector<uint8_t> const& enabled,
+                              std::vector<std::pair<uint32_t, uint32_t>>& pairs) {
+    pairs.clear();
+
+    size_t added = syncProxies(enabled);
+
+    // refresh endpoint values from this frames bounds
+    for (auto& endpoint : endpoints) {
+        AABB const& box = bounds[endpoint.data >> 1];
+        endpoint.value = (endpoint.data & 1u) ? box.max.x : box.min.x;
+    }
+
+    // objects barely move between steps so the list is almost sorted
+    sortEndpoints(added);
+
+    // sweep along x keeping a list of currently open intervals
+    active.clear();
+    activeBounds.clear();
+    for (auto const& endpoint : endpoints) {
+        uint32_t id = endpoint.data >> 1;
+
+        if (endpoint.data & 1u) {
+            auto index = static_cast<size_t>(std::find(active.begin(), active.end(), id) - active.begin());
+            active[index] = active.back();
+            active.pop_back();
+            activeBounds.swapRemove(index);
+            continue;
+        }
+
+        // x overlap is implied by the sweep, finish the test on y a batch at a time
+        for (size_t start = 0; start < active.size(); start += AABB_BATCH_WIDTH) {
+            uint32_t mask = activeBounds.overlapMask(bounds[id], start);
+
+            while (mask) {
+                uint32_t other = active[start + __builtin_ctz(mask)];
+                pairs.emplace_back(std::min(id, other), std::max(id, other));
+                mask &= mask - 1;
+            }
+        }
+        active.push_back(id);
+        activeBounds.push(bounds[id]);
+    }
+}
+
+void SweepAndPrune::clear() {
+    endpoints.clear();
+    inserted.clear();
+    active.clear();
+    activeBounds.clear();
+}
+
+size_t SweepAndPrune::syncProxies(std::vector<uint8_t> const& enabled) {
+    auto count = static_cast<uint32_t>(enabled.size());
+    bool removed = false;
+
+    // slots past the end of the world are gone
+    for (uint32_t slot = count; slot < inserted.size(); ++slot) {
+        removed = removed || inserted[slot];
+    }
+    inserted.resize(count, 0);
+
+    // new proxies get appended and merged into place by the next sort
+    size_t added = 0;
+    for (uint32_t slot = 0; slot < count; ++slot) {
+        if (enabled[slot] && !inserted[slot]) {
+            endpoints.push_back({0.0f, slot << 1});
+            endpoints.push_back({0.0f, (slot << 1) | 1u});
+            inserted[slot] = 1;
+            added += 2;
+        } else if (!enabled[slot] && inserted[slot]) {
+            inserted[slot] = 0;
+            removed = true;
+        }
+    }
+
+    if (removed) {
+        // drop endpoints belonging to removed proxies (keeps the order of everything else)
+        auto end = endpoints.end() - added;
+        auto kept = std::remove_if(endpoints.begin(), end, [this](Endpoint const& endpoint) {
+            uint32_t slot = endpoint.data >> 1;
+            return slot >= inserted.size() || !inserted[slot];
+        });
+        endpoints.erase(kept, end);
+    }
+
+    return added;
+}
+
+void SweepAndPrune::sortEndpoints(size_t added) {
+    size_t sorted = endpoints.size() - added;
+
+    // insertion sort (linear for nearly sorted input)
+    for (size_t i = 1; i < sorted; ++i) {
+        Endpoint key = endpoints[i];
+        size_t j = i;
+
+        while (j > 0 && endpointLess(key.value, key.data, endpoints[j - 1].value, endpoints[j - 1].data)) {
+            endpoints[j] = endpoints[j - 1];
+            --j;
+        }
+        endpoints[j] = key;
+    }
+
+    // newly added endpoints are in no particular order, sort them on their own and merge them in
+    if (added > 0) {
+        auto endpointOrder = [](Endpoint const& a, Endpoint const& b) {
+            return endpointLess(a.value, a.data, b.value, b.data);
+        };
+        auto middle = endpoints.begin() + sorted;
+        std::sort(middle, endpoints.end(), endpointOrder);
+        std::inplace_merge(endpoints.begin(), middle, endpoints.end(), endpointOrder);
+    }
+}
@@ -0,0 +1,47 @@
+//
+// Created by Victor Zhang on 17/10/26.
+//
+
+#ifndef BOYBOY_SWEEPANDPRUNE_HPP
+#define BOYBOY_SWEEPANDPRUNE_HPP
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+#include "AABB.hpp"
+#include "AABBBatch.hpp"
+
+// broadphase which keeps a sorted list of x axis endpoints between frames
+// proxies are world slots (bounds and enabled flags are indexed by slot), only enabled slots
+// have endpoints so toggling one slot never renumbers the others and the list stays almost sorted
+class SweepAndPrune {
+public:
+    SweepAndPrune() = default;
+    ~SweepAndPrune() = default;
+
+    // pairs are reported as slots
+    void findPairs(std::vector<AABB> const&, std::vector<uint8_t> const&, std::vector<std::pair<uint32_t, uint32_t>>&);
+    void clear();
+
+private:
+    struct Endpoint {
+        float value;
+        // proxy id << 1 | isMax
+        uint32_t data;
+    };
+
+    // adds and drops endpoints of slots which were enabled or disabled since the last call
+    // returns the number of endpoints appended (unsorted) to the end of the list
+    size_t syncProxies(std::vector<uint8_t> const&);
+    void sortEndpoints(size_t);
+
+    std::vector<Endpoint> endpoints;
+    // slots which currently have endpoints
+    std::vector<uint8_t> inserted;
+    // open intervals (ids and their bounds in matching order)
+    std::vector<uint32_t> active;
+    AABBBatch activeBounds;
+};
+
+#endif //BOYBOY_SWEEPANDPRUNE_HPP
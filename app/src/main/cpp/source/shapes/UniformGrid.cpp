@@ -0,0 +1,145 @@
+//
+// Created by Victor Zhang on 17/10/26.
+//
+
+#include <cmath>
+#include <algorithm>
+
+#include "UniformGrid.hpp"
+
+UniformGrid::UniformGrid(float width, float height, float cellSize) {
+    resize(width, height, cellSize);
+}
+
+void UniformGrid::resize(float width, float height, float size) {
+    cellSize = size;
+    columns = std::max(1, static_cast<int>(std::ceil(width / size)));
+    rows = std::max(1, static_cast<int>(std::ceil(height / size)));
+    originX = -width / 2;
+    originY = -height / 2;
+
+    cellStart.assign(static_cast<size_t>(columns * rows + 1), 0);
+}
+
+int UniformGrid::cellX(float x) const {
+    int cell = static_cast<int>(std::floor((x - originX) / cellSize));
+    return std::min(std::max(cell, 0), columns - 1);
+}
+
+int UniformGrid::cellY(float y) const {
+    int cell = static_cast<int>(std::floor((y - originY) / cellSize));
+    return std::min(std::max(cell, 0), rows - 1);
+}
+
+void UniformGrid::findPairs(std::vector<AABB> const& bounds, std::vector<std::pair<uint32_t, uint32_t>>& pairs) {
+    pairs.clear();
+    build(bounds);
+
+    for (int y = 0; y < rows; ++y) {
+        findRowPairs(bounds, y, pairs);
+    }
+}
+
+void UniformGrid::findPairs(std::vector<AABB> const& bounds, std::vector<std::pair<uint32_t, uint32_t>>& pairs, JobSystem& jobs) {
+    pairs.clear();
+    build(bounds);
+
+    // every row gets its own buffer so the merged order matches the serial version
+    if (rowPairs.size() < static_cast<size_t>(rows)) {
+        rowPairs.resize(static_cast<size_t>(rows));
+    }
+    jobs.parallelFor(static_cast<size_t>(rows), 1, [&](size_t begin, size_t end) {
+        for (size_t y = begin; y < end; ++y) {
+            rowPairs[y].clear();
+            findRowPairs(bounds, static_cast<int>(y), rowPairs[y]);
+        }
+    });
+
+    for (int y = 0; y < rows; ++y) {
+        pairs.insert(pairs.end(), rowPairs[y].begin(), rowPairs[y].end());
+    }
+}
+
+void UniformGrid::build(std::vector<AABB> const& bounds) {
+    size_t numCells = static_cast<size_t>(columns * rows);
+    std::fill(cellStart.begin(), cellStart.end(), 0);
+
+    // find covered cells and count entries per cell
+    ranges.resize(bounds.size());
+    for (size_t i = 0; i < bounds.size(); ++i) {
+        CellRange& range = ranges[i];
+        range.minX = cellX(bounds[i].min.x);
+        range.minY = cellY(bounds[i].min.y);
+        range.maxX = cellX(bounds[i].max.x);
+        range.maxY = cellY(bounds[i].max.y);
+
+        for (int y = range.minY; y <= range.maxY; ++y) {
+            for (int x = range.minX; x <= range.maxX; ++x) {
+                cellStart[y * columns + x + 1]++;
+            }
+        }
+    }
+
+    // prefix sum gives the start of each cell bucket
+    for (size_t cell = 0; cell < numCells; ++cell) {
+        cellStart[cell + 1] += cellStart[cell];
+    }
+
+    // bucket proxies (cellStart is shifted forward while filling then restored)
+    cellEntries.resize(cellStart[numCells]);
+    for (uint32_t i = 0; i < bounds.size(); ++i) {
+        CellRange const& range = ranges[i];
+        for (int y = range.minY; y <= range.maxY; ++y) {
+            for (int x = range.minX; x <= range.maxX; ++x) {
+                cellEntries[cellStart[y * columns + x]++] = i;
+            }
+        }
+    }
+    for (size_t cell = numCells; cell > 0; --cell) {
+        cellStart[cell] = cellStart[cell - 1];
+    }
+    cellStart[0] = 0;
+
+    // gather bounds in bucket order so each cell is contiguous
+    entryBounds.clear();
+    for (auto const& entry : cellEntries) {
+        entryBounds.push(bounds[entry]);
+    }
+
+}
+
+void UniformGrid::findRowPairs(std::vector<AABB> const& bounds, int y, std::vector<std::pair<uint32_t, uint32_t>>& pairs) const {
+    // test pairs sharing a cell
+    for (int x = 0; x < columns; ++x) {
+        uint32_t begin = cellStart[y * columns + x];
+        uint32_t end = cellStart[y * columns + x + 1];
+
+        for (uint32_t i = begin; i < end; ++i) {
+            uint32_t a = cellEntries[i];
+            CellRange const& rangeA = ranges[a];
+
+            for (uint32_t start = i + 1; start < end; start += AABB_BATCH_WIDTH) {
+                uint32_t mask = entryBounds.overlapMask(bounds[a], start);
+
+                // drop entries belonging to the next cell
+                if (end - start < AABB_BATCH_WIDTH) {
+                    mask &= (1u << (end - start)) - 1;
+                }
+
+                while (mask) {
+                    uint32_t b = cellEntries[start + __builtin_ctz(mask)];
+                    CellRange const& rangeB = ranges[b];
+                    mask &= mask - 1;
+
+                    // objects spanning several cells meet in more than one bucket,
+                    // only the first shared cell reports the pair
+                    if (std::max(rangeA.minX, rangeB.minX) != x || std::max(rangeA.minY, rangeB.minY) != y) {
+                        continue;
+                    }
+
+                    pairs.emplace_back(std::min(a, b), std::max(a, b));
+                }
+            }
+        }
+    }
+}
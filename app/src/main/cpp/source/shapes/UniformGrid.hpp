@@ -0,0 +1,51 @@
+//
+// Created by Victor Zhang on 17/10/26.
+//
+
+#ifndef BOYBOY_UNIFORMGRID_HPP
+#define BOYBOY_UNIFORMGRID_HPP
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+#include "AABB.hpp"
+#include "AABBBatch.hpp"
+#include "tools/JobSystem.hpp"
+
+// broadphase which buckets bounds into fixed size cells covering the world (centred on 0,0)
+// bounds outside of the world are clamped into the border cells
+class UniformGrid {
+public:
+    UniformGrid() : UniformGrid(1.0f, 1.0f, 1.0f) {}
+    UniformGrid(float, float, float);
+    ~UniformGrid() = default;
+
+    void resize(float, float, float);
+    void findPairs(std::vector<AABB> const&, std::vector<std::pair<uint32_t, uint32_t>>&);
+    // same pairs in the same order with the rows tested on the job system
+    void findPairs(std::vector<AABB> const&, std::vector<std::pair<uint32_t, uint32_t>>&, JobSystem&);
+
+private:
+    struct CellRange {
+        int minX, minY, maxX, maxY;
+    };
+
+    int cellX(float) const;
+    int cellY(float) const;
+    void build(std::vector<AABB> const&);
+    void findRowPairs(std::vector<AABB> const&, int, std::vector<std::pair<uint32_t, uint32_t>>&) const;
+
+    float originX, originY;
+    float cellSize;
+    int columns, rows;
+
+    std::vector<CellRange> ranges;
+    std::vector<uint32_t> cellStart;
+    std::vector<uint32_t> cellEntries;
+    // bounds gathered in cellEntries order
+    AABBBatch entryBounds;
+    std::vector<std::vector<std::pair<uint32_t, uint32_t>>> rowPairs;
+};
+
+#endif //BOYBOY_UNIFORMGRID_HPP
@@ -0,0 +1,253 @@
+//
+// Created by Victor Zhang on 17/10/26.
+//
+#define GLM_ENABLE_EXPERIMENTAL
+
+#include <algorithm>
+
+#include <glm/ext.hpp>
+
+#include "World.hpp"
+
+Entity World::create(const glm::vec3& translation, const glm::quat& rotation, const glm::vec3& scale,
+                     const AABB& localBounds, MeshType mesh, Entity parent) {
+    uint32_t parentSlot = isAlive(parent) ? parent.index : WORLD_NO_PARENT;
+    uint32_t slot = allocateSlot(parentSlot == WORLD_NO_PARENT ? 0 : parentSlot + 1);
+
+    alive[slot] = 1;
+    childCounts[slot] = 0;
+
+    translations[slot] = translation;
+    rotations[slot] = rotation;
+    scales[slot] = scale;
+    dirty[slot] = 1;
+
+    velocities[slot] = glm::vec3(0.0f, 0.0f, 0.0f);
+    bounds[slot] = AABB();
+    active[slot] = 1;
+
+    // start black like a fresh object
+    colors[slot] = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+    worldMatrices[slot] = glm::mat4(1.0f);
+    parents[slot] = parentSlot;
+    if (parentSlot != WORLD_NO_PARENT) {
+        childCounts[parentSlot]++;
+        childSlots++;
+    }
+
+    meshes[slot] = mesh;
+    localCenters[slot] = glm::vec3(localBounds.min + localBounds.max) * 0.5f;
+    localExtents[slot] = glm::vec3(localBounds.max - localBounds.min) * 0.5f;
+
+    return Entity{slot, generations[slot]};
+}
+
+void World::destroy(Entity entity) {
+    if (!isAlive(entity)) {
+        return;
+    }
+
+    uint32_t slot = entity.index;
+
+    // children always live after their parent
+    auto count = static_cast<uint32_t>(size());
+    for (uint32_t i = slot + 1; i < count && childCounts[slot] > 0; ++i) {
+        if (parents[i] == slot) {
+            destroy(Entity{i, generations[i]});
+        }
+    }
+
+    if (parents[slot] != WORLD_NO_PARENT) {
+        childCounts[parents[slot]]--;
+        childSlots--;
+    }
+
+    freeSlot(slot);
+}
+
+bool World::isAlive(Entity entity) const {
+    return entity.index < size() && alive[entity.index] && generations[entity.index] == entity.generation;
+}
+
+void World::clear() {
+    // newer slots start past every generation handed out so far so old handles stay dead
+    for (auto generation : generations) {
+        baseGeneration = std::max(baseGeneration, generation + 1);
+    }
+
+    generations.clear();
+    alive.clear();
+    childCounts.clear();
+    freeSlots.clear();
+    childSlots = 0;
+
+    translations.clear();
+    rotations.clear();
+    scales.clear();
+    dirty.clear();
+
+    velocities.clear();
+    bounds.clear();
+    active.clear();
+
+    colors.clear();
+    worldMatrices.clear();
+    parents.clear();
+
+    meshes.clear();
+    localCenters.clear();
+    localExtents.clear();
+}
+
+uint32_t World::allocateSlot(uint32_t minSlot) {
+    // reuse the last freed slot unless that would put a child ahead of its parent
+    if (!freeSlots.empty() && freeSlots.back() >= minSlot) {
+        uint32_t slot = freeSlots.back();
+        freeSlots.pop_back();
+        return slot;
+    }
+
+    auto slot = static_cast<uint32_t>(size());
+
+    generations.emplace_back(baseGeneration);
+    alive.emplace_back(0);
+    childCounts.emplace_back(0);
+
+    translations.emplace_back();
+    rotations.emplace_back();
+    scales.emplace_back();
+    dirty.emplace_back(0);
+
+    velocities.emplace_back();
+    bounds.emplace_back();
+    active.emplace_back(0);
+
+    colors.emplace_back();
+    worldMatrices.emplace_back();
+    parents.emplace_back(WORLD_NO_PARENT);
+
+    meshes.emplace_back(MeshType::NONE);
+    localCenters.emplace_back();
+    localExtents.emplace_back();
+
+    return slot;
+}
+
+void World::freeSlot(uint32_t slot) {
+    // leave the slot inert so the linear passes can skip over it without checks
+    alive[slot] = 0;
+    generations[slot]++;
+    childCounts[slot] = 0;
+
+    velocities[slot] = glm::vec3(0.0f, 0.0f, 0.0f);
+    active[slot] = 0;
+    dirty[slot] = 0;
+    parents[slot] = WORLD_NO_PARENT;
+    meshes[slot] = MeshType::NONE;
+
+    freeSlots.emplace_back(slot);
+}
+
+void World::setTranslation(Entity entity, const glm::vec3& translation) {
+    if (translations[entity.index] == translation) {
+        return;
+    }
+    translations[entity.index] = translation;
+    dirty[entity.index] = 1;
+}
+
+void World::setRotation(Entity entity, const glm::quat& rotation) {
+    if (rotations[entity.index] == rotation) {
+        return;
+    }
+    rotations[entity.index] = rotation;
+    dirty[entity.index] = 1;
+}
+
+void World::setScale(Entity entity, const glm::vec3& scale) {
+    if (scales[entity.index] == scale) {
+        return;
+    }
+    scales[entity.index] = scale;
+    dirty[entity.index] = 1;
+}
+
+void World::integrate(size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        // entities at rest keep their cached transforms
+        if (velocities[i] == glm::vec3(0.0f)) {
+            continue;
+        }
+        translations[i] += velocities[i];
+        dirty[i] = 1;
+    }
+}
+
+void World::updateTransforms() {
+    updateRootTransforms(0, size());
+    finishTransforms();
+}
+
+void World::updateRootTransforms(size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        if (!dirty[i] || parents[i] != WORLD_NO_PARENT) {
+            continue;
+        }
+        refreshSlot(i, glm::translate(translations[i]) * glm::toMat4(rotations[i]) * glm::scale(scales[i]));
+    }
+}
+
+void World::finishTransforms() {
+    // parents always come first so their matrices are already up to date
+    size_t count = size();
+    for (size_t i = 0; i < count && childSlots > 0; ++i) {
+        uint32_t parent = parents[i];
+        if (parent == WORLD_NO_PARENT || (!dirty[i] && !dirty[parent])) {
+            continue;
+        }
+        // mark so our own children get refreshed too
+        dirty[i] = 1;
+
+        glm::mat4 local = glm::translate(translations[i]) * glm::toMat4(rotations[i]) * glm::scale(scales[i]);
+        refreshSlot(i, worldMatrices[parent] * local);
+    }
+
+    std::fill(dirty.begin(), dirty.end(), 0);
+}
+
+void World::refreshSlot(size_t i, const glm::mat4& world) {
+    worldMatrices[i] = world;
+
+    // transform the local box extents instead of every vertex
+    glm::vec3 center = glm::vec3(world * glm::vec4(localCenters[i], 1.0f));
+    glm::mat3 absMat = glm::mat3(world);
+    absMat[0] = glm::abs(absMat[0]);
+    absMat[1] = glm::abs(absMat[1]);
+    absMat[2] = glm::abs(absMat[2]);
+    glm::vec3 extents = absMat * localExtents[i];
+
+    bounds[i] = AABB(glm::vec4(center - extents, 1.0f), glm::vec4(center + extents, 1.0f));
+}
+
+// fnv-1a over the raw bytes of each component array
+template <typename T>
+static uint64_t hashComponents(uint64_t hash, const std::vector<T>& components) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(components.data());
+    size_t length = components.size() * sizeof(T);
+    for (size_t i = 0; i < length; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+uint64_t World::checksum() const {
+    uint64_t hash = 14695981039346656037ULL;
+    hash = hashComponents(hash, active);
+    hash = hashComponents(hash, translations);
+    hash = hashComponents(hash, rotations);
+    hash = hashComponents(hash, scales);
+    hash = hashComponents(hash, velocities);
+    hash = hashComponents(hash, colors);
+    return hash;
+}
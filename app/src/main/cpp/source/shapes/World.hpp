@@ -0,0 +1,119 @@
+//
+// Created by Victor Zhang on 17/10/26.
+//
+
+#ifndef BOYBOY_WORLD_HPP
+#define BOYBOY_WORLD_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include "AABB.hpp"
+
+#define WORLD_NO_PARENT UINT32_MAX
+
+// stable handle to an entity
+// index is the slot in the component arrays, generation changes every time the slot is freed
+// so handles to destroyed entities never alias a newer entity in the same slot
+struct Entity {
+    uint32_t index;
+    uint32_t generation;
+
+    bool operator==(const Entity& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const Entity& other) const { return !(*this == other); }
+};
+
+#define WORLD_NULL_ENTITY (Entity{UINT32_MAX, 0})
+
+enum class MeshType : uint8_t {
+    NONE,
+    QUAD,
+};
+
+// dense component store for every game entity
+// each component lives in its own contiguous array indexed by slot so the per tick
+// passes (integrate, transforms, bounds) only touch the data they need
+// freed slots are recycled and stay inert (inactive, no velocity, no parent) until then
+// NOTE: a child always sits in a later slot than its parent (transforms are resolved in one linear pass)
+class World {
+public:
+    World() = default;
+    ~World() = default;
+
+    Entity create(const glm::vec3&, const glm::quat&, const glm::vec3&, const AABB&, MeshType, Entity);
+    void destroy(Entity);
+    void clear();
+    bool isAlive(Entity) const;
+    // number of slots (including freed ones) to iterate the component arrays with
+    size_t size() const { return translations.size(); }
+    size_t aliveCount() const { return size() - freeSlots.size(); }
+
+    void setTranslation(Entity, const glm::vec3&);
+    void setRotation(Entity, const glm::quat&);
+    void setScale(Entity, const glm::vec3&);
+    const glm::vec3& getTranslation(Entity entity) const { return translations[entity.index]; }
+    const glm::quat& getRotation(Entity entity) const { return rotations[entity.index]; }
+    const glm::vec3& getScale(Entity entity) const { return scales[entity.index]; }
+    // read only view for passes over every slot (writes must go through the setters)
+    const std::vector<glm::vec3>& getTranslations() const { return translations; }
+    const std::vector<glm::quat>& getRotations() const { return rotations; }
+    const std::vector<glm::vec3>& getScales() const { return scales; }
+
+    // moves every entity by its velocity
+    void integrate() { integrate(0, size()); }
+    // recomputes world matrices and bounds of changed entities (and their descendants)
+    void updateTransforms();
+
+    // range versions of the passes above so they can be split across threads
+    // every root range must be updated before finishTransforms resolves the children
+    void integrate(size_t, size_t);
+    void updateRootTransforms(size_t, size_t);
+    void finishTransforms();
+
+    // FNV-1a hash of the simulated state (bit exact, for catching replay divergence)
+    // slot bookkeeping (generations, free list) is left out so rebuilt worlds still match
+    uint64_t checksum() const;
+
+    // hot (touched by every tick)
+    std::vector<glm::vec3> velocities;
+    std::vector<AABB> bounds;
+    std::vector<uint8_t> active;
+
+    // warm (read by the renderer or on change)
+    std::vector<glm::vec4> colors;
+    std::vector<glm::mat4> worldMatrices;
+    // parent slot or WORLD_NO_PARENT
+    std::vector<uint32_t> parents;
+
+    // cold (set once on creation)
+    std::vector<MeshType> meshes;
+
+private:
+    uint32_t allocateSlot(uint32_t);
+    void freeSlot(uint32_t);
+    void refreshSlot(size_t, const glm::mat4&);
+
+    std::vector<uint32_t> generations;
+    std::vector<uint8_t> alive;
+    std::vector<uint32_t> childCounts;
+    // recycled slots (lifo)
+    std::vector<uint32_t> freeSlots;
+    uint32_t baseGeneration = 0;
+    // number of slots with a parent
+    size_t childSlots = 0;
+
+    std::vector<glm::vec3> translations;
+    std::vector<glm::quat> rotations;
+    std::vector<glm::vec3> scales;
+    std::vector<uint8_t> dirty;
+
+    // local space bounds of each entity's mesh
+    std::vector<glm::vec3> localCenters;
+    std::vector<glm::vec3> localExtents;
+};
+
+#endif //BOYBOY_WORLD_HPP
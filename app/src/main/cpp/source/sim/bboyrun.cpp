@@ -0,0 +1,345 @@
+//
+// Created by Victor Zhang on 17/10/26.
+//
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <cstring>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <getopt.h>
+
+#include "core/bboygame.hpp"
+#include "shapes/AABBBatch.hpp"
+#include "shapes/World.hpp"
+#include "tools/tools.hpp"
+#include "tools/TickScheduler.hpp"
+#include "tools/Trace.hpp"
+
+#define DEFAULT_TICKS 10000
+#define DEFAULT_SCREEN_WIDTH 1920
+#define DEFAULT_SCREEN_HEIGHT 1080
+
+static void printUsage(const char *name) {
+    fprintf(stderr,
+            "usage: %s [-t ticks] [-n bodies] [-s seed] [-W width] [-H height] [-b broadphase] [-c cell] [-j workers] [-r] [-u nanoseconds]\n"
+            "          [-f fingers] [-R log] [-k] [-P log] [-T trace] [-S]\n"
+            "  -t  number of simulation ticks to run (default %d)\n"
+            "  -n  extra bodies to spawn into the world (default 0)\n"
+            "  -s  rng seed (default random)\n"
+            "  -W  virtual screen width (default %d)\n"
+            "  -H  virtual screen height (default %d)\n"
+            "  -b  collision broadphase: sap, grid, tree (default grid)\n"
+            "  -c  grid cell size in world units (default %.1f)\n"
+            "  -j  job system worker threads (default one per extra core)\n"
+            "  -r  run in real time instead of as fast as possible\n"
+            "  -u  virtual time per update in bulk mode (default exactly one tick)\n"
+            "  -f  synthetic fingers circling the screen (default 0)\n"
+            "  -R  record every tick's input to a log\n"
+            "  -k  add a world checksum to every recorded tick\n"
+            "  -P  replay a log (world setup comes from the log, runs until it ends unless -t is given)\n"
+            "  -T  write a chrome trace of the run (needs a BBOY_TRACE build)\n"
+            "  -S  check the simd overlap kernel against the scalar one and exit\n",
+            name, DEFAULT_TICKS, DEFAULT_SCREEN_WIDTH, DEFAULT_SCREEN_HEIGHT, GRID_CELL_SIZE);
+}
+
+// fingers circling the middle of the screen, fed through the same path as real touches
+static void feedFingers(int fingers, int width, int height) {
+    int64_t now = getGameTime();
+    float angle = static_cast<float>(now % BILLION) / BILLION_FLOAT * 2.0f * M_PI_FLOAT;
+
+    struct EventItem events[MAX_POINTER_SIZE];
+    int32_t ids[MAX_POINTER_SIZE];
+    for (int i = 0; i < fingers; ++i) {
+        ids[i] = i;
+        float offset = angle + i * 2.0f * M_PI_FLOAT / fingers;
+        events[i] = EventItem(width * (0.5f + 0.25f * cosf(offset)), height * (0.5f + 0.25f * sinf(offset)));
+    }
+
+    storeEvent(events, ids, static_cast<size_t>(fingers), now);
+    processInput();
+}
+
+// compares every overlapMask bit of batch against overlapMaskScalar for box, returns the mismatches
+static int compareOverlapMasks(AABBBatch const& batch, AABB const& box) {
+    int mismatches = 0;
+    for (size_t start = 0; start < batch.size() + AABB_BATCH_WIDTH; ++start) {
+        uint32_t simd = batch.overlapMask(box, start);
+        uint32_t scalar = batch.overlapMaskScalar(box, start);
+        if (simd != scalar) {
+            fprintf(stderr, "overlap mask mismatch at %zu of %zu: simd 0x%02x scalar 0x%02x\n",
+                    start, batch.size(), simd, scalar);
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+// the simd overlap kernel has to agree with the scalar fallback bit for bit
+// (random, touching and NaN boxes, every batch alignment and padding tail)
+static int selfTest(uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> extent(0.0f, 4.0f);
+    float nan = std::numeric_limits<float>::quiet_NaN();
+
+    auto randomBox = [&]() {
+        float x = position(rng);
+        float y = position(rng);
+        return AABB(glm::vec4(x, y, 0.0f, 1.0f), glm::vec4(x + extent(rng), y + extent(rng), 0.0f, 1.0f));
+    };
+    // a box sharing an edge or corner with other (touching counts as overlapping)
+    auto touchingBox = [&](AABB const& other) {
+        glm::vec4 size = other.max - other.min;
+        glm::vec4 offset(rng() % 2 ? size.x : -size.x, rng() % 2 ? size.y : 0.0f, 0.0f, 0.0f);
+        return AABB(other.min + offset, other.max + offset);
+    };
+    auto nanBox = [&]() {
+        AABB box = randomBox();
+        switch (rng() % 4) {
+            case 0: box.min.x = nan; break;
+            case 1: box.min.y = nan; break;
+            case 2: box.max.x = nan; break;
+            default: box.max.y = nan; break;
+        }
+        return box;
+    };
+
+    int mismatches = 0;
+    AABBBatch batch;
+    for (int round = 0; round < 200; ++round) {
+        // every tail length, and leftovers from the previous round must read as padding
+        batch.clear();
+        size_t count = rng() % (4 * AABB_BATCH_WIDTH);
+        std::vector<AABB> boxes;
+        for (size_t i = 0; i < count; ++i) {
+            switch (rng() % 4) {
+                case 0: boxes.push_back(boxes.empty() ? randomBox() : touchingBox(boxes[rng() % boxes.size()])); break;
+                case 1: boxes.push_back(nanBox()); break;
+                default: boxes.push_back(randomBox()); break;
+            }
+            batch.push(boxes.back());
+        }
+
+        // swapRemove puts padding back behind the new last element
+        if (count > 0 && rng() % 2) {
+            batch.swapRemove(rng() % count);
+        }
+
+        for (int query = 0; query < 16; ++query) {
+            AABB box;
+            switch (rng() % 4) {
+                case 0: box = boxes.empty() ? randomBox() : touchingBox(boxes[rng() % boxes.size()]); break;
+                case 1: box = nanBox(); break;
+                default: box = randomBox(); break;
+            }
+            mismatches += compareOverlapMasks(batch, box);
+        }
+    }
+
+    printf("overlap kernel self test: %d mismatches\n", mismatches);
+    return mismatches;
+}
+
+int main(int argc, char **argv) {
+    long ticks = DEFAULT_TICKS;
+    int bodies = 0;
+    int width = DEFAULT_SCREEN_WIDTH;
+    int height = DEFAULT_SCREEN_HEIGHT;
+    float cellSize = GRID_CELL_SIZE;
+    BroadphaseType broadphase = BroadphaseType::UNIFORM_GRID;
+    int workers = -1;
+    bool realtime = false;
+    int64_t updateStep = 0;
+    bool seeded = false;
+    uint32_t seed = 0;
+    bool ticksGiven = false;
+    int fingers = 0;
+    const char *recordPath = nullptr;
+    bool checksums = false;
+    const char *replayPath = nullptr;
+    const char *tracePath = nullptr;
+    bool runSelfTest = false;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "t:n:s:W:H:b:c:j:ru:f:R:kP:T:S")) != -1) {
+        switch (opt) {
+            case 't':
+                ticks = strtol(optarg, nullptr, 10);
+                ticksGiven = true;
+                break;
+            case 'n':
+                bodies = atoi(optarg);
+                break;
+            case 's':
+                seed = static_cast<uint32_t>(strtoul(optarg, nullptr, 10));
+                seeded = true;
+                break;
+            case 'W':
+                width = atoi(optarg);
+                break;
+            case 'H':
+                height = atoi(optarg);
+                break;
+            case 'b':
+                if (strcmp(optarg, "sap") == 0) {
+                    broadphase = BroadphaseType::SWEEP_AND_PRUNE;
+                } else if (strcmp(optarg, "grid") == 0) {
+                    broadphase = BroadphaseType::UNIFORM_GRID;
+                } else if (strcmp(optarg, "tree") == 0) {
+                    broadphase = BroadphaseType::AABB_TREE;
+                } else {
+                    printUsage(argv[0]);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'c':
+                cellSize = strtof(optarg, nullptr);
+                break;
+            case 'j':
+                workers = atoi(optarg);
+                break;
+            case 'r':
+                realtime = true;
+                break;
+            case 'u':
+                updateStep = strtoll(optarg, nullptr, 10);
+                break;
+            case 'f':
+                fingers = atoi(optarg);
+                break;
+            case 'R':
+                recordPath = optarg;
+                break;
+            case 'k':
+                checksums = true;
+                break;
+            case 'P':
+                replayPath = optarg;
+                break;
+            case 'T':
+                tracePath = optarg;
+                break;
+            case 'S':
+                runSelfTest = true;
+                break;
+            default:
+                printUsage(argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    if (ticks <= 0 || bodies < 0 || width <= 1 || height <= 1 || cellSize <= 0.0f || updateStep < 0 ||
+        fingers < 0 || fingers > MAX_POINTER_SIZE) {
+        printUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (runSelfTest) {
+        return selfTest(seeded ? seed : 1) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    // setup the world exactly as the engine would (minus the renderer)
+    initGame();
+    // bulk runs are driven by virtual time so they are deterministic and unthrottled
+    setClockType(realtime ? ClockType::MONOTONIC : ClockType::VIRTUAL);
+    if (seeded) {
+        seedGame(seed);
+    }
+    setupWorld(width, height);
+    setBroadphase(broadphase);
+    setGridCellSize(cellSize);
+    if (workers >= 0) {
+        setWorkerCount(workers);
+    }
+    initGameObjects();
+    spawnGameObjects(bodies);
+
+    if (replayPath != nullptr && !startReplay(replayPath)) {
+        return EXIT_FAILURE;
+    }
+    if (recordPath != nullptr && !startRecording(recordPath, checksums)) {
+        return EXIT_FAILURE;
+    }
+
+    struct timespec start;
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    resetGameTime();
+
+    // paced the same way as the engine game loop
+    TickScheduler scheduler(TICK_SPIN_NS);
+
+    TRACE_THREAD_NAME("game");
+    if (tracePath != nullptr) {
+        Trace::start();
+    }
+
+    uint64_t updates = 0;
+    int64_t gameStart = getGameTime();
+    uint64_t target = static_cast<uint64_t>(ticks);
+    while (getGameStats().steppedFrame < target) {
+        if (replayPath != nullptr && !isReplaying() && !ticksGiven) {
+            break;
+        }
+
+        if (fingers > 0) {
+            feedFingers(fingers, width, height);
+        }
+
+        if (realtime) {
+            updateGame();
+            scheduler.waitUntil(getNextTickTime());
+        } else {
+            // either exactly one tick per update or a fixed step (anything over a tick exercises frame skip)
+            if (updateStep > 0) {
+                advanceGameClock(updateStep);
+            } else {
+                advanceGameClockTo(getNextTickTime());
+            }
+            updateGame();
+        }
+        updates++;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    if (tracePath != nullptr) {
+        Trace::stop();
+        Trace::exportJson(tracePath);
+    }
+    float elapsed = getElapsedTime(start, end);
+
+    GameStats stats = getGameStats();
+    printf("mode: %s\n", realtime ? "realtime" : "bulk");
+    printf("objects: %zu\n", getWorld().aliveCount());
+    printf("ticks: %llu\n", static_cast<unsigned long long>(stats.steppedFrame));
+    printf("updates: %llu\n", static_cast<unsigned long long>(updates));
+    printf("game time: %.3f s\n", (getGameTime() - gameStart) / BILLION_FLOAT);
+    printf("elapsed: %.3f s\n", elapsed);
+    printf("ticks/sec: %.1f\n", stats.steppedFrame / elapsed);
+    // only the last few seconds are kept (the rolling timing window)
+    GameTimings timings = getGameTimings();
+    printf("tick time: p50 %.3f ms, p90 %.3f ms, p99 %.3f ms, max %.3f ms\n",
+           timings.tickTime.p50 / 1e6, timings.tickTime.p90 / 1e6,
+           timings.tickTime.p99 / 1e6, timings.tickTime.max / 1e6);
+    printf("steps per update: p50 %lld, p99 %lld, max %lld\n",
+           static_cast<long long>(timings.stepsPerUpdate.p50),
+           static_cast<long long>(timings.stepsPerUpdate.p99),
+           static_cast<long long>(timings.stepsPerUpdate.max));
+    if (replayPath != nullptr) {
+        printf("replay divergences: %llu\n", static_cast<unsigned long long>(getReplayDivergences()));
+    }
+    if (realtime) {
+        SchedulerStats schedulerStats = scheduler.getStats();
+        printf("late ticks: %llu\n", static_cast<unsigned long long>(schedulerStats.late));
+        printf("overshoot mean: %.3f ms\n", schedulerStats.meanOvershoot / 1e6);
+        printf("overshoot max: %.3f ms\n", schedulerStats.maxOvershoot / 1e6);
+    }
+
+    uint64_t divergences = getReplayDivergences();
+    shutdownGame();
+
+    return divergences == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,47 @@
+//
+// Created by Victor Zhang on 17/10/26.
+//
+
+#include <ctime>
+
+#include "Clock.hpp"
+#include "tools.hpp"
+
+int64_t Clock::now() const {
+    switch (type) {
+        case ClockType::VIRTUAL:
+            return virtualTime.load(std::memory_order_acquire);
+        case ClockType::MONOTONIC:
+        default:
+            return monotonicNow();
+    }
+}
+
+void Clock::setType(ClockType clockType) {
+    virtualTime.store(monotonicNow(), std::memory_order_release);
+    type = clockType;
+}
+
+void Clock::advance(int64_t nanoseconds) {
+    if (type != ClockType::VIRTUAL || nanoseconds <= 0) {
+        return;
+    }
+
+    virtualTime.fetch_add(nanoseconds, std::memory_order_acq_rel);
+}
+
+void Clock::advanceTo(int64_t time) {
+    if (type != ClockType::VIRTUAL) {
+        return;
+    }
+
+    int64_t current = virtualTime.load(std::memory_order_relaxed);
+    while (current < time && !virtualTime.compare_exchange_weak(current, time, std::memory_order_acq_rel)) {
+    }
+}
+
+int64_t Clock::monotonicNow() {
+    struct timespec res;
+    clock_gettime(CLOCK_MONOTONIC, &res);
+    return getNanoseconds(res);
+}
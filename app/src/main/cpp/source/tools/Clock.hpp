@@ -0,0 +1,43 @@
+//
+// Created by Victor Zhang on 17/10/26.
+//
+
+#ifndef BOYBOY_CLOCK_HPP
+#define BOYBOY_CLOCK_HPP
+
+#include <atomic>
+#include <cstdint>
+
+enum class ClockType {
+    MONOTONIC,
+    VIRTUAL,
+};
+
+// nanosecond time source for the game
+// MONOTONIC reads CLOCK_MONOTONIC, VIRTUAL only moves when advanced (deterministic and as fast as you like)
+class Clock {
+public:
+    explicit Clock(ClockType type = ClockType::MONOTONIC) : type(type), virtualTime(0) {}
+
+    Clock(const Clock&) = delete;
+    Clock& operator=(const Clock&) = delete;
+
+    // any thread
+    int64_t now() const;
+    ClockType getType() const { return type; }
+
+    // switching type restarts virtual time at the current monotonic time (so timestamps stay comparable)
+    void setType(ClockType);
+
+    // virtual clocks only (ignored otherwise), time never runs backwards
+    void advance(int64_t);
+    void advanceTo(int64_t);
+
+    static int64_t monotonicNow();
+
+private:
+    ClockType type;
+    std::atomic<int64_t> virtualTime;
+};
+
+#endif //BOYBOY_CLOCK_HPP
@@ -0,0 +1,133 @@
+//
+// Created by Victor Zhang on 17/10/26.
+//
+
+#include <algorithm>
+#include <cmath>
+
+#include "Histogram.hpp"
+
+#define HISTOGRAM_SUB_COUNT (1 << HISTOGRAM_SUB_BITS)
+// one linear run of exact values then one run of sub buckets per power of two
+#define HISTOGRAM_BUCKET_COUNT ((HISTOGRAM_MAX_BITS - HISTOGRAM_SUB_BITS + 1) * HISTOGRAM_SUB_COUNT)
+
+Histogram::Histogram() : counts(HISTOGRAM_BUCKET_COUNT, 0), count(0), max(0) {}
+
+size_t Histogram::bucketIndex(int64_t value) {
+    if (value < HISTOGRAM_SUB_COUNT) {
+        return static_cast<size_t>(std::max<int64_t>(value, 0));
+    }
+
+    // exponent past the exact run and the sub bucket within that power of two
+    int msb = 63 - __builtin_clzll(static_cast<uint64_t>(value));
+    if (msb >= HISTOGRAM_MAX_BITS) {
+        return HISTOGRAM_BUCKET_COUNT - 1;
+    }
+    int exponent = msb - HISTOGRAM_SUB_BITS;
+    size_t sub = static_cast<size_t>(value >> exponent) - HISTOGRAM_SUB_COUNT;
+
+    return static_cast<size_t>(exponent + 1) * HISTOGRAM_SUB_COUNT + sub;
+}
+
+int64_t Histogram::bucketUpperBound(size_t index) {
+    if (index < HISTOGRAM_SUB_COUNT) {
+        return static_cast<int64_t>(index);
+    }
+
+    int exponent = static_cast<int>(index / HISTOGRAM_SUB_COUNT) - 1;
+    int64_t sub = static_cast<int64_t>(index % HISTOGRAM_SUB_COUNT);
+
+    return ((sub + HISTOGRAM_SUB_COUNT + 1) << exponent) - 1;
+}
+
+void Histogram::record(int64_t value) {
+    counts[bucketIndex(value)]++;
+    count++;
+    max = std::max(max, value);
+}
+
+void Histogram::add(const Histogram& other) {
+    for (size_t i = 0; i < counts.size(); ++i) {
+        counts[i] += other.counts[i];
+    }
+    count += other.count;
+    max = std::max(max, other.max);
+}
+
+void Histogram::reset() {
+    std::fill(counts.begin(), counts.end(), 0);
+    count = 0;
+    max = 0;
+}
+
+int64_t Histogram::getPercentile(float percentile) const {
+    if (count == 0) {
+        return 0;
+    }
+
+    // rank of the sample we are after (1 based)
+    auto rank = static_cast<uint64_t>(std::ceil(std::min(std::max(percentile, 0.0f), 100.0f) / 100.0f * count));
+    rank = std::max<uint64_t>(rank, 1);
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        seen += counts[i];
+        if (seen >= rank) {
+            return std::min(bucketUpperBound(i), max);
+        }
+    }
+
+    return max;
+}
+
+HistogramSummary Histogram::getSummary() const {
+    HistogramSummary summary;
+    summary.count = count;
+    summary.p50 = getPercentile(50.0f);
+    summary.p90 = getPercentile(90.0f);
+    summary.p99 = getPercentile(99.0f);
+    summary.max = max;
+    return summary;
+}
+
+RollingHistogram::RollingHistogram(int64_t sliceLength, size_t sliceCount)
+        : sliceLength(sliceLength), slices(sliceCount), epochs(sliceCount, -1) {}
+
+void RollingHistogram::record(int64_t value, int64_t now) {
+    int64_t epoch = now / sliceLength;
+    size_t slice = static_cast<size_t>(epoch % static_cast<int64_t>(slices.size()));
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // the slice still holds an older part of the window, recycle it
+    if (epochs[slice] != epoch) {
+        slices[slice].reset();
+        epochs[slice] = epoch;
+    }
+    slices[slice].record(value);
+}
+
+HistogramSummary RollingHistogram::getSummary(int64_t now) const {
+    int64_t epoch = now / sliceLength;
+    auto sliceCount = static_cast<int64_t>(slices.size());
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    merged.reset();
+    for (size_t i = 0; i < slices.size(); ++i) {
+        if (epochs[i] > epoch - sliceCount && epochs[i] <= epoch) {
+            merged.add(slices[i]);
+        }
+    }
+
+    return merged.getSummary();
+}
+
+void RollingHistogram::reset() {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (size_t i = 0; i < slices.size(); ++i) {
+        slices[i].reset();
+        epochs[i] = -1;
+    }
+}
@@ -0,0 +1,77 @@
+//
+// Created by Victor Zhang on 17/10/26.
+//
+
+#ifndef BOYBOY_HISTOGRAM_HPP
+#define BOYBOY_HISTOGRAM_HPP
+
+#include <vector>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+
+// values below 2^HISTOGRAM_SUB_BITS are counted exactly, larger ones within 1 / 2^HISTOGRAM_SUB_BITS (~3%)
+#define HISTOGRAM_SUB_BITS 5
+// anything at or above 2^HISTOGRAM_MAX_BITS lands in the last bucket (~18 minutes of nanoseconds)
+#define HISTOGRAM_MAX_BITS 40
+
+struct HistogramSummary {
+    uint64_t count;
+    int64_t p50;
+    int64_t p90;
+    int64_t p99;
+    int64_t max;
+};
+
+// log linear bucketed histogram of non negative values (HdrHistogram style)
+// fixed memory, O(1) record and percentiles that keep the tail instead of averaging it away
+class Histogram {
+public:
+    Histogram();
+
+    void record(int64_t);
+    void add(const Histogram&);
+    void reset();
+
+    uint64_t getCount() const { return count; }
+    int64_t getMax() const { return max; }
+    // highest value equivalent to the given percentile [0, 100] (never above the real max)
+    int64_t getPercentile(float) const;
+    HistogramSummary getSummary() const;
+
+private:
+    static size_t bucketIndex(int64_t);
+    static int64_t bucketUpperBound(size_t);
+
+    std::vector<uint32_t> counts;
+    uint64_t count;
+    int64_t max;
+};
+
+// histogram over a rolling time window made of sliceCount slices of sliceLength each
+// recording and summaries may come from any thread
+class RollingHistogram {
+public:
+    RollingHistogram(int64_t, size_t);
+
+    RollingHistogram(const RollingHistogram&) = delete;
+    RollingHistogram& operator=(const RollingHistogram&) = delete;
+
+    // value recorded at the given time (any monotonic nanoseconds, must not run backwards by more than a slice)
+    void record(int64_t, int64_t);
+    // everything recorded within the window ending at the given time
+    HistogramSummary getSummary(int64_t) const;
+    void reset();
+
+private:
+    const int64_t sliceLength;
+
+    mutable std::mutex mutex;
+    std::vector<Histogram> slices;
+    // which slice of time each slice currently holds
+    std::vector<int64_t> epochs;
+    // scratch for merging the slices
+    mutable Histogram merged;
+};
+
+#endif //BOYBOY_HISTOGRAM_HPP
@@ -0,0 +1,150 @@
+//
+// Created by Victor Zhang on 17/10/26.
+//
+
+#include <cstring>
+
+#include "InputLog.hpp"
+
+#define INPUT_LOG_MAGIC "BBIL"
+#define INPUT_LOG_VERSION 1
+#define INPUT_LOG_FLAG_CHECKSUMS 0x1
+
+template <typename T>
+static bool writeValue(FILE* file, const T& value) {
+    return fwrite(&value, sizeof(T), 1, file) == 1;
+}
+
+template <typename T>
+static bool readValue(FILE* file, T& value) {
+    return fread(&value, sizeof(T), 1, file) == 1;
+}
+
+bool InputLog::openWrite(const char* path, const InputLogHeader& header) {
+    close();
+
+    file = fopen(path, "wb");
+    if (file == nullptr) {
+        LOGE("could not open input log %s for writing", path);
+        return false;
+    }
+
+    writing = true;
+    checksums = header.checksums;
+    ticks = 0;
+
+    uint32_t flags = checksums ? INPUT_LOG_FLAG_CHECKSUMS : 0;
+    bool ok = fwrite(INPUT_LOG_MAGIC, 4, 1, file) == 1 &&
+              writeValue(file, static_cast<uint32_t>(INPUT_LOG_VERSION)) &&
+              writeValue(file, header.seed) &&
+              writeValue(file, header.screenWidth) &&
+              writeValue(file, header.screenHeight) &&
+              writeValue(file, header.spawnCount) &&
+              writeValue(file, flags);
+    if (!ok) {
+        LOGE("could not write input log header to %s", path);
+        close();
+    }
+
+    return ok;
+}
+
+bool InputLog::openRead(const char* path, InputLogHeader& header) {
+    close();
+
+    file = fopen(path, "rb");
+    if (file == nullptr) {
+        LOGE("could not open input log %s", path);
+        return false;
+    }
+
+    writing = false;
+    ticks = 0;
+
+    char magic[4];
+    uint32_t version = 0;
+    uint32_t flags = 0;
+    bool ok = fread(magic, 4, 1, file) == 1 && memcmp(magic, INPUT_LOG_MAGIC, 4) == 0 &&
+              readValue(file, version) && version == INPUT_LOG_VERSION &&
+              readValue(file, header.seed) &&
+              readValue(file, header.screenWidth) &&
+              readValue(file, header.screenHeight) &&
+              readValue(file, header.spawnCount) &&
+              readValue(file, flags);
+    if (!ok) {
+        LOGE("%s is not a version %d input log", path, INPUT_LOG_VERSION);
+        close();
+        return false;
+    }
+
+    checksums = (flags & INPUT_LOG_FLAG_CHECKSUMS) != 0;
+    header.checksums = checksums;
+
+    return true;
+}
+
+void InputLog::close() {
+    if (file != nullptr) {
+        fclose(file);
+        file = nullptr;
+    }
+}
+
+bool InputLog::writeTick(struct EventItem const* positions, uint32_t count, uint64_t checksum) {
+    if (!isWriting()) {
+        return false;
+    }
+
+    auto pointers = static_cast<uint8_t>(count < MAX_POINTER_SIZE ? count : MAX_POINTER_SIZE);
+    bool ok = writeValue(file, pointers);
+    for (uint8_t i = 0; ok && i < pointers; ++i) {
+        ok = writeValue(file, positions[i].x) && writeValue(file, positions[i].y);
+    }
+    if (ok && checksums) {
+        ok = writeValue(file, checksum);
+    }
+
+    if (!ok) {
+        LOGE("could not write input log tick %llu", static_cast<unsigned long long>(ticks));
+        close();
+        return false;
+    }
+
+    ticks++;
+    return true;
+}
+
+bool InputLog::readTick(struct EventItem* positions, uint32_t& count, uint64_t& checksum) {
+    if (!isReading()) {
+        return false;
+    }
+
+    uint8_t pointers = 0;
+    bool ok = readValue(file, pointers) && pointers <= MAX_POINTER_SIZE;
+    for (uint8_t i = 0; ok && i < pointers; ++i) {
+        ok = readValue(file, positions[i].x) && readValue(file, positions[i].y);
+    }
+    checksum = 0;
+    if (ok && checksums) {
+        ok = readValue(file, checksum);
+    }
+
+    if (!ok) {
+        // a truncated last record just ends the log
+        close();
+        return false;
+    }
+
+    count = pointers;
+    ticks++;
+
+    // close straight away after the last record so isReading() is false once the log runs out
+    int next = fgetc(file);
+    if (next == EOF) {
+        close();
+    } else {
+        ungetc(next, file);
+    }
+
+    return true;
+}
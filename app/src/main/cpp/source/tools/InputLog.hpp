@@ -0,0 +1,60 @@
+//
+// Created by Victor Zhang on 17/10/26.
+//
+
+#ifndef BOYBOY_INPUTLOG_HPP
+#define BOYBOY_INPUTLOG_HPP
+
+#include <cstdio>
+#include <cstdint>
+
+#include "core/bboycore.hpp"
+
+// everything needed to rebuild the world a log was recorded against
+struct InputLogHeader {
+    uint32_t seed;
+    int32_t screenWidth;
+    int32_t screenHeight;
+    uint32_t spawnCount;
+    // every tick record carries a world checksum
+    bool checksums;
+};
+
+// compact binary log of the pointer positions each tick stepped with
+//
+//  header: "BBIL" | u32 version | u32 seed | i32 width | i32 height | u32 spawn count | u32 flags
+//  tick:   u8 pointer count | count * (f32 x, f32 y) world positions | [u64 checksum]
+//
+// values are written in host byte order (logs are replayed on the same kind of machine)
+class InputLog {
+public:
+    InputLog() : file(nullptr), writing(false), checksums(false), ticks(0) {}
+    ~InputLog() { close(); }
+
+    InputLog(const InputLog&) = delete;
+    InputLog& operator=(const InputLog&) = delete;
+
+    bool openWrite(const char*, const InputLogHeader&);
+    bool openRead(const char*, InputLogHeader&);
+    void close();
+
+    bool isOpen() const { return file != nullptr; }
+    bool isWriting() const { return file != nullptr && writing; }
+    bool isReading() const { return file != nullptr && !writing; }
+    bool hasChecksums() const { return checksums; }
+    // ticks written or read so far
+    uint64_t getTicks() const { return ticks; }
+
+    bool writeTick(struct EventItem const*, uint32_t, uint64_t);
+    // positions must hold MAX_POINTER_SIZE items, false at the end of the log (or on a damaged record)
+    // the log closes itself after handing out its last record
+    bool readTick(struct EventItem*, uint32_t&, uint64_t&);
+
+private:
+    FILE* file;
+    bool writing;
+    bool checksums;
+    uint64_t ticks;
+};
+
+#endif //BOYBOY_INPUTLOG_HPP
@@ -0,0 +1,161 @@
+//
+// Created by Victor Zhang on 17/10/26.
+//
+
+#include <algorithm>
+
+#include "JobSystem.hpp"
+#include "Trace.hpp"
+
+#define JOB_QUEUE_INITIAL_SIZE 64
+
+void JobSystem::WorkQueue::push(const Task& task) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // grow and unwrap the ring when full
+    if (count == tasks.size()) {
+        std::vector<Task> grown(std::max<size_t>(JOB_QUEUE_INITIAL_SIZE, tasks.size() * 2));
+        for (size_t i = 0; i < count; ++i) {
+            grown[i] = tasks[(head + i) % tasks.size()];
+        }
+        tasks.swap(grown);
+        head = 0;
+    }
+
+    tasks[(head + count) % tasks.size()] = task;
+    count++;
+}
+
+bool JobSystem::WorkQueue::pop(Task& task) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (count == 0) {
+        return false;
+    }
+
+    // owner takes the most recently pushed task
+    count--;
+    task = tasks[(head + count) % tasks.size()];
+    return true;
+}
+
+bool JobSystem::WorkQueue::steal(Task& task) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (count == 0) {
+        return false;
+    }
+
+    // thieves take the oldest task
+    task = tasks[head];
+    head = (head + 1) % tasks.size();
+    count--;
+    return true;
+}
+
+JobSystem::JobSystem(unsigned workerCount) : queuedTasks(0), pendingTasks(0), running(true) {
+    // queue 0 belongs to the thread calling parallelFor
+    for (unsigned i = 0; i <= workerCount; ++i) {
+        queues.emplace_back(new WorkQueue());
+    }
+
+    for (unsigned i = 1; i <= workerCount; ++i) {
+        workers.emplace_back(&JobSystem::workerLoop, this, static_cast<size_t>(i));
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        running = false;
+    }
+    sleepCondition.notify_all();
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+unsigned JobSystem::defaultWorkerCount() {
+    // the calling thread works too
+    unsigned cores = std::thread::hardware_concurrency();
+    return cores > 1 ? cores - 1 : 0;
+}
+
+void JobSystem::submit(void (*run)(void*, size_t, size_t), void* context, size_t count, size_t grain) {
+    size_t chunks = chunkCount(count, grain);
+
+    pendingTasks.store(chunks, std::memory_order_relaxed);
+
+    // count the chunks before any is visible, a worker still spinning from the last call could
+    // otherwise take one and wrap the counter below zero (which keeps every sleeper awake)
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        queuedTasks.fetch_add(chunks, std::memory_order_release);
+    }
+
+    // deal each deque (caller and workers) a contiguous block of chunks so every thread
+    // starts on its own work and only steals once it runs dry
+    size_t queueCount = queues.size();
+    for (size_t queue = 0; queue < queueCount; ++queue) {
+        size_t first = chunks * queue / queueCount;
+        size_t last = chunks * (queue + 1) / queueCount;
+
+        // push in reverse so the owner pops its chunks in order while thieves take the far end
+        for (size_t chunk = last; chunk > first; --chunk) {
+            size_t begin = (chunk - 1) * grain;
+            queues[queue]->push(Task{run, context, begin, std::min(begin + grain, count)});
+        }
+    }
+
+    sleepCondition.notify_all();
+
+    // help out until every chunk is done
+    while (pendingTasks.load(std::memory_order_acquire) > 0) {
+        if (!runTask(0)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+bool JobSystem::runTask(size_t self) {
+    Task task;
+    bool found = queues[self]->pop(task);
+
+    for (size_t i = 1; !found && i < queues.size(); ++i) {
+        found = queues[(self + i) % queues.size()]->steal(task);
+    }
+
+    if (!found) {
+        return false;
+    }
+
+    queuedTasks.fetch_sub(1, std::memory_order_relaxed);
+    {
+        TRACE_ZONE("job");
+        task.run(task.context, task.begin, task.end);
+    }
+    pendingTasks.fetch_sub(1, std::memory_order_acq_rel);
+
+    return true;
+}
+
+void JobSystem::workerLoop(size_t self) {
+    TRACE_THREAD_NAME("worker");
+
+    while (true) {
+        if (runTask(self)) {
+            continue;
+        }
+
+        // sleep until there is something to steal (keeps idle cores idle)
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepCondition.wait(lock, [this] {
+            return !running || queuedTasks.load(std::memory_order_acquire) > 0;
+        });
+
+        if (!running) {
+            return;
+        }
+    }
+}
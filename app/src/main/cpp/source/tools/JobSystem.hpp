@@ -0,0 +1,93 @@
+//
+// Created by Victor Zhang on 17/10/26.
+//
+
+#ifndef BOYBOY_JOBSYSTEM_HPP
+#define BOYBOY_JOBSYSTEM_HPP
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <memory>
+#include <cstddef>
+
+// fixed pool of worker threads, each with its own deque of range tasks
+// parallelFor deals the chunks across every deque, workers pop from the back of their own
+// deque and steal from the front of the others
+// NOTE: parallelFor must only be called from one thread at a time and never from inside a task
+class JobSystem {
+public:
+    explicit JobSystem(unsigned);
+    JobSystem() : JobSystem(defaultWorkerCount()) {}
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // workers plus the calling thread
+    unsigned getThreadCount() const { return static_cast<unsigned>(queues.size()); }
+
+    // splits [0, count) into chunks of grain size and runs callback(begin, end) on each
+    // the chunk index of a range is begin / grain, returns once every chunk has finished
+    template <typename T> void parallelFor(size_t, size_t, T);
+
+    static unsigned defaultWorkerCount();
+    static size_t chunkCount(size_t count, size_t grain) { return (count + grain - 1) / grain; }
+
+private:
+    struct Task {
+        void (*run)(void*, size_t, size_t);
+        void* context;
+        size_t begin;
+        size_t end;
+    };
+
+    // ring buffer deque (only grows so steady state pushes never allocate)
+    struct WorkQueue {
+        std::mutex mutex;
+        std::vector<Task> tasks;
+        size_t head = 0;
+        size_t count = 0;
+
+        void push(const Task&);
+        bool pop(Task&);
+        bool steal(Task&);
+    };
+
+    void submit(void (*)(void*, size_t, size_t), void*, size_t, size_t);
+    bool runTask(size_t);
+    void workerLoop(size_t);
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex sleepMutex;
+    std::condition_variable sleepCondition;
+    std::atomic<size_t> queuedTasks;
+    std::atomic<size_t> pendingTasks;
+    bool running;
+};
+
+template <typename T>
+void JobSystem::parallelFor(size_t count, size_t grain, T callback) {
+    if (count == 0) {
+        return;
+    }
+    if (grain == 0) {
+        grain = 1;
+    }
+
+    // nothing to share, skip the queues entirely
+    if (workers.empty() || count <= grain) {
+        callback(static_cast<size_t>(0), count);
+        return;
+    }
+
+    submit([](void* context, size_t begin, size_t end) {
+        (*static_cast<T*>(context))(begin, end);
+    }, &callback, count, grain);
+}
+
+#endif //BOYBOY_JOBSYSTEM_HPP
@@ -0,0 +1,125 @@
+//
+// Created by Victor Zhang on 17/10/26.
+//
+
+#ifndef BOYBOY_SEQRING_HPP
+#define BOYBOY_SEQRING_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+// fixed capacity single producer / single consumer ring which never blocks the producer
+// when the consumer falls behind the oldest unread items are overwritten (only the newest N survive)
+// every slot is guarded by a sequence number so the consumer can detect an item being overwritten
+// while it copies it, item data is moved as relaxed atomic words so there is no data race either way
+template <typename T, size_t N>
+class SeqRing {
+    static_assert(std::is_trivially_copyable<T>::value, "SeqRing items are copied word by word");
+    static_assert(N > 0, "SeqRing needs at least one slot");
+
+public:
+    SeqRing() : head(0), tail(0), dropped(0) {
+        for (auto& slot : slots) {
+            slot.sequence.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // producer only
+    void push(const T&);
+
+    // consumer only, false when there is nothing new
+    bool pop(T&);
+    // consumer only, number of items overwritten before they were read
+    uint64_t getDropped() const { return dropped; }
+
+    // consumer only
+    void clear() { tail = head.load(std::memory_order_acquire); }
+
+private:
+    static const size_t WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    struct Slot {
+        // 2n + 1 while item n is being written, 2n + 2 once it is complete
+        std::atomic<uint64_t> sequence;
+        std::atomic<uint64_t> words[WORDS];
+    };
+
+    bool read(uint64_t, T&);
+
+    Slot slots[N];
+    std::atomic<uint64_t> head;
+    uint64_t tail;
+    uint64_t dropped;
+};
+
+template <typename T, size_t N>
+void SeqRing<T, N>::push(const T& item) {
+    uint64_t index = head.load(std::memory_order_relaxed);
+    Slot& slot = slots[index % N];
+
+    uint64_t words[WORDS] = {};
+    std::memcpy(words, &item, sizeof(T));
+
+    slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < WORDS; ++i) {
+        slot.words[i].store(words[i], std::memory_order_relaxed);
+    }
+    slot.sequence.store(2 * index + 2, std::memory_order_release);
+
+    head.store(index + 1, std::memory_order_release);
+}
+
+template <typename T, size_t N>
+bool SeqRing<T, N>::read(uint64_t index, T& item) {
+    Slot& slot = slots[index % N];
+
+    uint64_t before = slot.sequence.load(std::memory_order_acquire);
+    if (before != 2 * index + 2) {
+        return false;
+    }
+
+    uint64_t words[WORDS];
+    for (size_t i = 0; i < WORDS; ++i) {
+        words[i] = slot.words[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    // overwritten while copying
+    if (slot.sequence.load(std::memory_order_relaxed) != before) {
+        return false;
+    }
+
+    std::memcpy(&item, words, sizeof(T));
+    return true;
+}
+
+template <typename T, size_t N>
+bool SeqRing<T, N>::pop(T& item) {
+    while (true) {
+        uint64_t newest = head.load(std::memory_order_acquire);
+        if (tail >= newest) {
+            return false;
+        }
+
+        // lapped by the producer, jump to the oldest item still in the ring
+        if (newest - tail > N) {
+            dropped += newest - N - tail;
+            tail = newest - N;
+        }
+
+        if (read(tail, item)) {
+            tail++;
+            return true;
+        }
+
+        // the slot was reused under us so the producer must have moved on, catch up and retry
+        dropped++;
+        tail++;
+    }
+}
+
+#endif //BOYBOY_SEQRING_HPP
@@ -0,0 +1,80 @@
+//
+// Created by Victor Zhang on 17/10/26.
+//
+
+#include <chrono>
+#include <thread>
+#include <algorithm>
+
+#include "TickScheduler.hpp"
+#include "Clock.hpp"
+
+bool TickScheduler::waitUntil(int64_t deadline) {
+    std::unique_lock<std::mutex> lock(mutex);
+
+    int64_t current = now();
+    bool missed = current >= deadline;
+
+    // leave the last stretch to the spin below
+    int64_t sleepUntil = deadline - spinWindow;
+    while (!woken && current < sleepUntil) {
+        condition.wait_for(lock, std::chrono::nanoseconds(sleepUntil - current));
+        current = now();
+    }
+
+    if (woken) {
+        woken = false;
+        wakeups++;
+        return false;
+    }
+
+    lock.unlock();
+    while ((current = now()) < deadline) {
+        std::this_thread::yield();
+    }
+    lock.lock();
+
+    int64_t overshoot = current - deadline;
+    ticks++;
+    if (missed) {
+        late++;
+    }
+    totalOvershoot += overshoot;
+    maxOvershoot = std::max(maxOvershoot, overshoot);
+
+    return true;
+}
+
+void TickScheduler::notify() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        woken = true;
+    }
+    condition.notify_one();
+}
+
+SchedulerStats TickScheduler::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    SchedulerStats stats;
+    stats.ticks = ticks;
+    stats.late = late;
+    stats.wakeups = wakeups;
+    stats.meanOvershoot = ticks > 0 ? totalOvershoot / static_cast<int64_t>(ticks) : 0;
+    stats.maxOvershoot = maxOvershoot;
+    return stats;
+}
+
+void TickScheduler::resetStats() {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    ticks = 0;
+    late = 0;
+    wakeups = 0;
+    totalOvershoot = 0;
+    maxOvershoot = 0;
+}
+
+int64_t TickScheduler::now() {
+    return Clock::monotonicNow();
+}
@@ -0,0 +1,59 @@
+//
+// Created by Victor Zhang on 17/10/26.
+//
+
+#ifndef BOYBOY_TICKSCHEDULER_HPP
+#define BOYBOY_TICKSCHEDULER_HPP
+
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+
+struct SchedulerStats {
+    // deadlines reached
+    uint64_t ticks;
+    // deadlines which had already passed when the wait started
+    uint64_t late;
+    // waits cut short by notify
+    uint64_t wakeups;
+    // nanoseconds woken past the deadline
+    int64_t meanOvershoot;
+    int64_t maxOvershoot;
+};
+
+// paces a loop against CLOCK_MONOTONIC deadlines without burning a core
+// sleeps on a condition variable until just before the deadline then spins out the rest
+// (OS timers routinely wake a millisecond late), notify from any thread cuts the sleep short
+class TickScheduler {
+public:
+    explicit TickScheduler(int64_t spinWindow) : spinWindow(spinWindow), woken(false) { resetStats(); }
+
+    TickScheduler(const TickScheduler&) = delete;
+    TickScheduler& operator=(const TickScheduler&) = delete;
+
+    // blocks until the deadline (nanoseconds), false when woken early by notify
+    bool waitUntil(int64_t);
+    // any thread, wakes the current (or next) wait
+    void notify();
+
+    SchedulerStats getStats() const;
+    void resetStats();
+
+    static int64_t now();
+
+private:
+    const int64_t spinWindow;
+
+    mutable std::mutex mutex;
+    std::condition_variable condition;
+    bool woken;
+
+    // guarded by mutex
+    uint64_t ticks;
+    uint64_t late;
+    uint64_t wakeups;
+    int64_t totalOvershoot;
+    int64_t maxOvershoot;
+};
+
+#endif //BOYBOY_TICKSCHEDULER_HPP
@@ -0,0 +1,154 @@
+//
+// Created by Victor Zhang on 17/10/26.
+//
+
+#include <cstdio>
+#include <mutex>
+#include <memory>
+#include <vector>
+
+#include "core/bboycore.hpp"
+#include "Trace.hpp"
+#include "Clock.hpp"
+
+// zones kept per thread per capture (later zones are dropped)
+#define TRACE_BUFFER_EVENTS 65536
+#define TRACE_THREAD_NAME_SIZE 32
+
+namespace {
+    struct TraceEvent {
+        const char* name;
+        int64_t begin;
+        int64_t end;
+    };
+
+    // written only by its owning thread, read by the exporter up to count
+    struct TraceBuffer {
+        uint32_t tid;
+        char threadName[TRACE_THREAD_NAME_SIZE];
+        // capture the events belong to (the owner starts over when a new capture begins)
+        std::atomic<uint32_t> capture;
+        std::atomic<size_t> count;
+        uint64_t dropped;
+        std::unique_ptr<TraceEvent[]> events;
+    };
+
+    std::atomic<bool> enabled(false);
+    std::atomic<uint32_t> currentCapture(0);
+
+    // buffers are never freed (a thread may exit with events still waiting to be exported)
+    std::mutex buffersMutex;
+    std::vector<std::unique_ptr<TraceBuffer>> buffers;
+
+    thread_local TraceBuffer* threadBuffer = nullptr;
+
+    TraceBuffer* getThreadBuffer() {
+        if (threadBuffer != nullptr) {
+            return threadBuffer;
+        }
+
+        std::unique_ptr<TraceBuffer> buffer(new TraceBuffer());
+        buffer->threadName[0] = '\0';
+        buffer->capture.store(currentCapture.load(std::memory_order_acquire), std::memory_order_relaxed);
+        buffer->count.store(0, std::memory_order_relaxed);
+        buffer->dropped = 0;
+        buffer->events.reset(new TraceEvent[TRACE_BUFFER_EVENTS]);
+
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        buffer->tid = static_cast<uint32_t>(buffers.size() + 1);
+        threadBuffer = buffer.get();
+        buffers.emplace_back(std::move(buffer));
+
+        return threadBuffer;
+    }
+}
+
+void Trace::start() {
+    currentCapture.fetch_add(1, std::memory_order_acq_rel);
+    enabled.store(true, std::memory_order_release);
+}
+
+void Trace::stop() {
+    enabled.store(false, std::memory_order_release);
+}
+
+bool Trace::isEnabled() {
+    return enabled.load(std::memory_order_relaxed);
+}
+
+void Trace::setThreadName(const char* name) {
+    TraceBuffer* buffer = getThreadBuffer();
+
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    snprintf(buffer->threadName, TRACE_THREAD_NAME_SIZE, "%s", name);
+}
+
+void Trace::record(const char* name, int64_t begin, int64_t end) {
+    TraceBuffer* buffer = getThreadBuffer();
+
+    uint32_t capture = currentCapture.load(std::memory_order_acquire);
+    if (buffer->capture.load(std::memory_order_relaxed) != capture) {
+        buffer->count.store(0, std::memory_order_relaxed);
+        buffer->dropped = 0;
+        buffer->capture.store(capture, std::memory_order_release);
+    }
+
+    size_t index = buffer->count.load(std::memory_order_relaxed);
+    if (index >= TRACE_BUFFER_EVENTS) {
+        buffer->dropped++;
+        return;
+    }
+
+    buffer->events[index] = TraceEvent{name, begin, end};
+    buffer->count.store(index + 1, std::memory_order_release);
+}
+
+int64_t Trace::now() {
+    return Clock::monotonicNow();
+}
+
+bool Trace::exportJson(const char* path) {
+    FILE* file = fopen(path, "w");
+    if (file == nullptr) {
+        LOGE("could not open trace file %s", path);
+        return false;
+    }
+
+    uint32_t capture = currentCapture.load(std::memory_order_acquire);
+    size_t exported = 0;
+    bool first = true;
+
+    fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    for (auto const& buffer : buffers) {
+        if (buffer->threadName[0] != '\0') {
+            fprintf(file, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+                    first ? "" : ",", buffer->tid, buffer->threadName);
+            first = false;
+        }
+
+        // a thread which has not recorded since the capture started holds nothing of it
+        if (buffer->capture.load(std::memory_order_acquire) != capture) {
+            continue;
+        }
+
+        size_t count = buffer->count.load(std::memory_order_acquire);
+        for (size_t i = 0; i < count; ++i) {
+            TraceEvent const& event = buffer->events[i];
+            // trace event timestamps are in microseconds
+            fprintf(file, "%s\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                    first ? "" : ",", event.name, buffer->tid,
+                    event.begin / 1000.0, (event.end - event.begin) / 1000.0);
+            first = false;
+        }
+        exported += count;
+    }
+
+    fprintf(file, "\n]}\n");
+    bool ok = ferror(file) == 0;
+    fclose(file);
+
+    LOGI("exported %zu trace events to %s", exported, path);
+    return ok;
+}
@@ -0,0 +1,59 @@
+//
+// Created by Victor Zhang on 17/10/26.
+//
+
+#ifndef BOYBOY_TRACE_HPP
+#define BOYBOY_TRACE_HPP
+
+#include <atomic>
+#include <cstdint>
+
+// per thread trace buffers exported as chrome trace event json (chrome://tracing, ui.perfetto.dev)
+// zones only record between start and stop, each thread appends to its own buffer without locking
+// NOTE: names must be string literals (only the pointer is stored)
+namespace Trace {
+    // starts a new capture (drops whatever the previous one recorded)
+    void start();
+    void stop();
+    bool isEnabled();
+    // writes everything recorded by the current (or last) capture, safe while still capturing
+    bool exportJson(const char*);
+
+    // label the calling thread in exported traces
+    void setThreadName(const char*);
+    // one complete zone on the calling thread (nanoseconds)
+    void record(const char*, int64_t, int64_t);
+
+    int64_t now();
+}
+
+// times the enclosing scope while a capture is running
+class TraceZone {
+public:
+    explicit TraceZone(const char* name) : name(name), begin(Trace::isEnabled() ? Trace::now() : -1) {}
+    ~TraceZone() {
+        if (begin >= 0) {
+            Trace::record(name, begin, Trace::now());
+        }
+    }
+
+    TraceZone(const TraceZone&) = delete;
+    TraceZone& operator=(const TraceZone&) = delete;
+
+private:
+    const char* name;
+    int64_t begin;
+};
+
+// zones compile to nothing unless the build enables BBOY_TRACE
+#ifdef BBOY_TRACE
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_ZONE(name) TraceZone TRACE_CONCAT(traceZone, __LINE__)(name)
+#define TRACE_THREAD_NAME(name) Trace::setThreadName(name)
+#else
+#define TRACE_ZONE(name)
+#define TRACE_THREAD_NAME(name)
+#endif
+
+#endif //BOYBOY_TRACE_HPP
@@ -0,0 +1,51 @@
+//
+// Created by Victor Zhang on 17/10/26.
+//
+
+#ifndef BOYBOY_TRIPLEBUFFER_HPP
+#define BOYBOY_TRIPLEBUFFER_HPP
+
+#include <atomic>
+#include <cstdint>
+
+// lock free hand over of whole values from one producer thread to one consumer thread
+// the producer fills the back buffer and publishes it, the consumer picks up the newest published
+// buffer whenever it likes, neither side ever waits and the buffers are reused (no allocation)
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() : back(0), middle(1), front(2) {}
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // producer only
+    T& getBack() { return buffers[back]; }
+    void publish() {
+        uint8_t previous = middle.exchange(static_cast<uint8_t>(back | FRESH), std::memory_order_acq_rel);
+        back = previous & INDEX_MASK;
+    }
+
+    // consumer only, swaps in the newest published buffer (false when there is nothing new)
+    bool update() {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH)) {
+            return false;
+        }
+        uint8_t previous = middle.exchange(front, std::memory_order_acq_rel);
+        front = previous & INDEX_MASK;
+        return true;
+    }
+    const T& getFront() const { return buffers[front]; }
+
+private:
+    static const uint8_t INDEX_MASK = 0x3;
+    static const uint8_t FRESH = 0x4;
+
+    T buffers[3];
+    uint8_t back;
+    // index of the buffer in the middle, FRESH once the producer has published it
+    std::atomic<uint8_t> middle;
+    uint8_t front;
+};
+
+#endif //BOYBOY_TRIPLEBUFFER_HPP
@@ -25,3 +25,24 @@ void printCurrentThread(const char* threadName) {
     std::string id_string = ss.str();
     LOGI("%s thread: %s", id_string.c_str(), threadName);
 }
+
+float getElapsedTime(struct timespec const& prevTime, struct timespec const& curTime) {
+    // calculate elapsed time between prev and cur
+    time_t elapsedSec = curTime.tv_sec - prevTime.tv_sec;
+    long elapsedNSec = curTime.tv_nsec - prevTime.tv_nsec;
+
+    // subtraction carry
+    if (prevTime.tv_nsec > curTime.tv_nsec) {
+        --elapsedSec;
+        elapsedNSec += BILLION;
+    }
+
+    // convert to float
+    float elapsed = elapsedSec + elapsedNSec / BILLION_FLOAT;
+
+    return elapsed;
+}
+
+int64_t getNanoseconds(struct timespec const& time) {
+    return static_cast<int64_t>(time.tv_sec) * BILLION + time.tv_nsec;
+}
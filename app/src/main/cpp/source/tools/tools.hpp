@@ -5,10 +5,17 @@
 #ifndef BOYBOY_TOOLS_H
 #define BOYBOY_TOOLS_H
 
+#include <ctime>
+#include <cstdint>
+
 float degToRads(float);
 
 bool almostEquals(float, float);
 
 void printCurrentThread(const char*);
 
+float getElapsedTime(struct timespec const&, struct timespec const&);
+
+int64_t getNanoseconds(struct timespec const&);
+
 #endif //BOYBOY_TOOLS_H
@@ -1,18 +1,24 @@
 package xyz.velvetmilk.boyboyemulator
 
 import android.app.Application
+import java.io.File
 
 /**
  * @author Victor Zhang
  */
 class BBoyApp: Application() {
+    companion object {
+        // writes the session input to files/input.bil for replaying with bboyrun
+        private const val RECORDING = false
+    }
 
     override fun onCreate() {
         super.onCreate()
 
         // init java game engine
         BBoyServiceProvider.getInstance().initGameEngine()
-        BBoyServiceProvider.getInstance().gameEngine.initGameLoop()
+        val recordPath = if (RECORDING) File(filesDir, "input.bil").absolutePath else null
+        BBoyServiceProvider.getInstance().gameEngine.initGameLoop(recordPath)
     }
 
     override fun onTerminate() {
@@ -6,10 +6,11 @@ package xyz.velvetmilk.boyboyemulator
 class BBoyFPSRunner(private val fpsInfo: BBoyFPS,
                     private val fpsUpdateListener: OnFPSUpdateListener): Runnable {
     @Volatile private var running: Boolean = true
+    private val telemetry = BBoyTelemetry(BBoyJNILib.obtainTelemetry())
 
     override fun run() {
         while (running) {
-            BBoyJNILib.obtainFPS(fpsInfo)
+            telemetry.read(fpsInfo)
 
             fpsUpdateListener.onFPSUpdate()
 
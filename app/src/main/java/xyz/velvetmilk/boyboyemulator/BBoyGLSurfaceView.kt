@@ -42,6 +42,11 @@ class BBoyGLSurfaceView: GLSurfaceView {
         fun onOpenGLReady()
     }
 
+    // reused between touch events, grown when a batch carries more samples than seen before
+    private var touchPositions = FloatArray(MAX_TOUCH_POINTERS * 2)
+    private val touchIds = IntArray(MAX_TOUCH_POINTERS)
+    private var touchTimestamps = LongArray(1)
+
     lateinit var openGLVersion: String
     lateinit var openGLRenderer: String
     lateinit var openGLExtensions: String
@@ -60,6 +65,7 @@ class BBoyGLSurfaceView: GLSurfaceView {
     companion object {
         private val TAG = BBoyGLSurfaceView::class.java.simpleName
         private const val MAX_TOUCH_POINTERS = 10
+        private const val NANOS_PER_MILLI = 1_000_000L
 
         private fun checkEglError(prompt: String) {
             var error: Int
@@ -83,9 +89,7 @@ class BBoyGLSurfaceView: GLSurfaceView {
         super.onTouchEvent(event)
 
         // NOTE: multi-touch
-        // problem is how to assign touchpointer id with which touch slot
-        // right now (since touchevents are discrete and shouldnt interact with each other)
-        // we can safely ignore which touch correlates to which pointer
+        // pointer indices shift as fingers go up and down, the engine follows fingers by pointer id
         val touchers = if (event.pointerCount > MAX_TOUCH_POINTERS) {
             MAX_TOUCH_POINTERS
         } else {
@@ -95,35 +99,36 @@ class BBoyGLSurfaceView: GLSurfaceView {
         val xPrecision = event.xPrecision
         val yPrecision = event.yPrecision
 
-        val touchList: MutableList<BBoyInputEvent> = mutableListOf()
+        val frames = event.historySize + 1
+        if (touchTimestamps.size < frames) {
+            touchPositions = FloatArray(frames * MAX_TOUCH_POINTERS * 2)
+            touchTimestamps = LongArray(frames)
+        }
 
         for (i in 0 until touchers) {
-            var x: Float = event.getX(i) * xPrecision
-            var y: Float = event.getY(i) * yPrecision
-
-            // if (x is almost an int) --> use int version
-            // @TODO fix epsilon to a better value than constant recalculation
-            // @TODO change to multiple of ulp if required???
-            // @TODO optmise if this is really slow
-            val roundedX = x.roundToInt().toFloat()
-            val roundedY = y.roundToInt().toFloat()
-
-            var epsilon = Math.ulp(roundedX)
-            if (roundedX != x && (roundedX - x).absoluteValue <= epsilon) {
-                x = roundedX
-            }
+            touchIds[i] = event.getPointerId(i)
+        }
 
-            epsilon = Math.ulp(roundedY)
-            if (roundedY != y && (roundedY - y).absoluteValue <= epsilon) {
-                y = roundedY
-            }
+        // batched historical samples first then the current one, each as a frame of every pointer
+        var offset = 0
+        for (h in 0 until frames) {
+            val isCurrent = h == event.historySize
+            val eventTime = if (isCurrent) event.eventTime else event.getHistoricalEventTime(h)
+
+            // event time is uptimeMillis which shares CLOCK_MONOTONIC with the engine
+            touchTimestamps[h] = eventTime * NANOS_PER_MILLI
+
+            for (i in 0 until touchers) {
+                val x = if (isCurrent) event.getX(i) else event.getHistoricalX(i, h)
+                val y = if (isCurrent) event.getY(i) else event.getHistoricalY(i, h)
 
-            touchList.add(BBoyInputEvent(x, y))
+                touchPositions[offset++] = snapToInt(x * xPrecision)
+                touchPositions[offset++] = snapToInt(y * yPrecision)
+            }
         }
 
         //Log.d(TAG, "x: " + event.x * event.xPrecision + " | y: " + event.y * event.xPrecision)
-//        BBoyJNILib.sendEvent(BBoyInputEvent(x, y))
-        BBoyJNILib.sendEvent(touchList.toTypedArray())
+        BBoyJNILib.sendEvents(touchPositions, touchIds, touchTimestamps, frames, touchers)
 
         when (event.action and MotionEvent.ACTION_MASK) {
             MotionEvent.ACTION_DOWN -> {
@@ -145,6 +150,21 @@ class BBoyGLSurfaceView: GLSurfaceView {
         return false
     }
 
+    // if (x is almost an int) --> use int version
+    // @TODO fix epsilon to a better value than constant recalculation
+    // @TODO change to multiple of ulp if required???
+    // @TODO optmise if this is really slow
+    private fun snapToInt(value: Float): Float {
+        val rounded = value.roundToInt().toFloat()
+        val epsilon = Math.ulp(rounded)
+
+        if (rounded != value && (rounded - value).absoluteValue <= epsilon) {
+            return rounded
+        }
+
+        return value
+    }
+
     // Because we call this from onTouchEvent, this code will be executed for both
     // normal touch events and for when the system calls this using Accessibility
     override fun performClick(): Boolean {
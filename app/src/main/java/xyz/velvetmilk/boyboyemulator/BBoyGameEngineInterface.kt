@@ -50,8 +50,11 @@ class BBoyGameEngineInterface {
         BBoyJNILib.printOpenGLInfo()
     }
 
-    fun initGameLoop() {
+    fun initGameLoop(recordPath: String? = null) {
         BBoyJNILib.init()
+        if (recordPath != null) {
+            BBoyJNILib.startRecording(recordPath, true)
+        }
     }
     
     fun runGameLoop() {
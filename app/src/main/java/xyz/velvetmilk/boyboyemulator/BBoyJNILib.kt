@@ -4,6 +4,7 @@ import android.opengl.GLES10
 import android.opengl.GLES32
 import android.util.Log
 import android.view.MotionEvent
+import java.nio.ByteBuffer
 import java.nio.IntBuffer
 import javax.microedition.khronos.opengles.GL10
 
@@ -28,6 +29,13 @@ class BBoyJNILib {
         @JvmStatic
         external fun setup(width: Int, height: Int)
 
+        /**
+         * Records every tick's input to path so bboyrun can replay it (call between init and run)
+         * @param checksums also store a world checksum per tick to catch replay divergence
+         */
+        @JvmStatic
+        external fun startRecording(path: String, checksums: Boolean)
+
         @JvmStatic
         external fun run()
 
@@ -49,17 +57,44 @@ class BBoyJNILib {
         @JvmStatic
         external fun shutdown()
 
+        /**
+         * Direct buffer over the native telemetry block, valid for the lifetime of the library (see BBoyTelemetry)
+         */
+        @JvmStatic
+        external fun obtainTelemetry(): ByteBuffer
+
+        /**
+         * Timing histograms over the last few seconds, written as count, p50, p90, p99, max for
+         * frame time, render time, tick time (all nanoseconds) and steps per update in turn (20 values)
+         */
+        @JvmStatic
+        external fun obtainTimings(timings: LongArray)
+
+        /**
+         * Starts capturing trace zones (native builds with BBOY_TRACE only, otherwise nothing is recorded)
+         */
         @JvmStatic
-        external fun obtainFPS(fpsInfo: BBoyFPS)
+        external fun startTrace()
 
+        /**
+         * Stops the capture and writes it to path as Chrome trace event JSON
+         */
         @JvmStatic
-        external fun obtainPos(): Array<BBoyInputEvent>
+        external fun stopTrace(path: String): Boolean
 
+        /**
+         * Direct buffer over the native pointer block, valid for the lifetime of the library (see BBoyPointers)
+         */
         @JvmStatic
-        external fun obtainPosInplace(posInfoArray: Array<BBoyInputEvent>)
+        external fun obtainPointers(): ByteBuffer
 
+        /**
+         * @param positions frameCount frames of pointerCount screen (x, y) pairs each (oldest first)
+         * @param pointerIds MotionEvent pointer id of each pointer (the same for every frame)
+         * @param timestamps one per frame in CLOCK_MONOTONIC nanoseconds
+         */
         @JvmStatic
-        external fun sendEvent(event: Array<BBoyInputEvent>)
+        external fun sendEvents(positions: FloatArray, pointerIds: IntArray, timestamps: LongArray, frameCount: Int, pointerCount: Int)
 
         fun printOpenGLInfo() {
 //            val buffer = IntBuffer.allocate(1)
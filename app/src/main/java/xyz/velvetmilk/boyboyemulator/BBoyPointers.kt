@@ -0,0 +1,78 @@
+package xyz.velvetmilk.boyboyemulator
+
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+
+/**
+ * Reads the native pointer block (see PointerBlock in bboycore.cpp, the offsets must match)
+ * straight out of native memory, no JNI call or allocation per read
+ *
+ * The game thread alternates between two seqlocked slots, the latest one is read and the read is
+ * retried if the slot was rewritten underneath it
+ *
+ * @author Victor Zhang
+ */
+class BBoyPointers(buffer: ByteBuffer) {
+
+    companion object {
+        private const val VERSION = 1
+        private const val MAX_POINTER_SIZE = 10
+        private const val MAX_RETRIES = 16
+
+        private const val LATEST_OFFSET = 0
+        private const val VERSION_OFFSET = 4
+        private const val SLOTS_OFFSET = 8
+        private const val SLOT_SIZE = 8 + MAX_POINTER_SIZE * 16
+        private const val SLOT_SEQUENCE_OFFSET = 0
+        private const val SLOT_COUNT_OFFSET = 4
+        private const val SLOT_VALUES_OFFSET = 8
+    }
+
+    private val block: ByteBuffer = buffer.order(ByteOrder.nativeOrder())
+    // reused for every read so the pointer runner never allocates
+    private val pool: Array<BBoyInputEvent> = Array(MAX_POINTER_SIZE) { BBoyInputEvent() }
+    private val values: FloatArray = FloatArray(MAX_POINTER_SIZE * 4)
+
+    // @NOTE no VarHandle below api 33, volatile accesses stand in for the acquire fences (display only positions)
+    @Volatile private var fence: Int = 0
+
+    init {
+        check(block.getInt(VERSION_OFFSET) == VERSION) { "pointer block version mismatch" }
+    }
+
+    /**
+     * Replaces the contents of inputInfo with the latest pointers (the events are owned by this
+     * reader and overwritten by the next read), returns false (leaving inputInfo untouched) if the
+     * writer kept interfering
+     */
+    fun read(inputInfo: MutableList<BBoyInputEvent>): Boolean {
+        for (i in 0 until MAX_RETRIES) {
+            val slot = SLOTS_OFFSET + (block.getInt(LATEST_OFFSET) and 1) * SLOT_SIZE
+            val sequence = block.getInt(slot + SLOT_SEQUENCE_OFFSET)
+            if (sequence and 1 != 0) {
+                continue
+            }
+            fence = sequence
+
+            val count = minOf(block.getInt(slot + SLOT_COUNT_OFFSET), MAX_POINTER_SIZE)
+            for (j in 0 until count * 4) {
+                values[j] = block.getFloat(slot + SLOT_VALUES_OFFSET + j * 4)
+            }
+
+            if (fence == sequence && block.getInt(slot + SLOT_SEQUENCE_OFFSET) == sequence) {
+                inputInfo.clear()
+                for (j in 0 until count) {
+                    val event = pool[j]
+                    event.x = values[j * 4]
+                    event.y = values[j * 4 + 1]
+                    event.normX = values[j * 4 + 2]
+                    event.normY = values[j * 4 + 3]
+                    inputInfo.add(event)
+                }
+                return true
+            }
+        }
+
+        return false
+    }
+}
@@ -6,13 +6,11 @@ package xyz.velvetmilk.boyboyemulator
 class BBoyPosRunner(private val inputInfo: MutableList<BBoyInputEvent>,
                     private val posUpdateListener: OnPosUpdateListener): Runnable {
     @Volatile private var running: Boolean = true
+    private val pointers = BBoyPointers(BBoyJNILib.obtainPointers())
 
     override fun run() {
         while (running) {
-            val posInfo: Array<BBoyInputEvent> = BBoyJNILib.obtainPos()
-
-            inputInfo.clear()
-            inputInfo.addAll(posInfo)
+            pointers.read(inputInfo)
 
             posUpdateListener.onPosUpdate()
 
@@ -0,0 +1,75 @@
+package xyz.velvetmilk.boyboyemulator
+
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+
+/**
+ * Reads the native telemetry block (see TelemetryBlock in bboycore.cpp, the offsets must match)
+ * straight out of native memory, no JNI call per read
+ *
+ * The block is a seqlock with the game thread as its only writer: an odd sequence means a write
+ * is in progress and a changed sequence means the read was torn, either way the read is retried
+ *
+ * @author Victor Zhang
+ */
+class BBoyTelemetry(buffer: ByteBuffer) {
+
+    companion object {
+        private const val VERSION = 1
+        private const val MAX_RETRIES = 16
+
+        private const val SEQUENCE_OFFSET = 0
+        private const val VERSION_OFFSET = 4
+        private const val FPS_OFFSET = 8
+        private const val UPS_OFFSET = 12
+        private const val TRUE_UPS_OFFSET = 16
+        private const val SPS_OFFSET = 20
+        private const val FRAME_OFFSET = 24
+        private const val STEPPED_FRAME_OFFSET = 32
+        private const val CUR_TIME_OFFSET = 40
+    }
+
+    private val block: ByteBuffer = buffer.order(ByteOrder.nativeOrder())
+
+    // @NOTE no VarHandle below api 33, volatile accesses stand in for the acquire fences (display only stats)
+    @Volatile private var fence: Int = 0
+
+    init {
+        check(block.getInt(VERSION_OFFSET) == VERSION) { "telemetry block version mismatch" }
+    }
+
+    /**
+     * Copies a consistent snapshot into fpsInfo, returns false (leaving fpsInfo untouched) if the
+     * writer kept interfering
+     */
+    fun read(fpsInfo: BBoyFPS): Boolean {
+        for (i in 0 until MAX_RETRIES) {
+            val sequence = block.getInt(SEQUENCE_OFFSET)
+            if (sequence and 1 != 0) {
+                continue
+            }
+            fence = sequence
+
+            val fps = block.getFloat(FPS_OFFSET)
+            val ups = block.getFloat(UPS_OFFSET)
+            val trueUps = block.getFloat(TRUE_UPS_OFFSET)
+            val sps = block.getFloat(SPS_OFFSET)
+            val frame = block.getLong(FRAME_OFFSET)
+            val steppedFrame = block.getLong(STEPPED_FRAME_OFFSET)
+            val curTime = block.getLong(CUR_TIME_OFFSET)
+
+            if (fence == sequence && block.getInt(SEQUENCE_OFFSET) == sequence) {
+                fpsInfo.fps = fps
+                fpsInfo.ups = ups
+                fpsInfo.true_ups = trueUps
+                fpsInfo.sps = sps
+                fpsInfo.frame = frame
+                fpsInfo.stepped_frame = steppedFrame
+                fpsInfo.cur_time = curTime
+                return true
+            }
+        }
+
+        return false
+    }
+}